@@ -0,0 +1,44 @@
+#include "AllocCounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    std::atomic<uint64_t> allocCount{0};
+    std::atomic<uint64_t> allocBytes{0};
+
+    void *countedAlloc(std::size_t size)
+    {
+        allocCount.fetch_add(1, std::memory_order_relaxed);
+        allocBytes.fetch_add(size, std::memory_order_relaxed);
+        if (void *p = std::malloc(size ? size : 1))
+            return p;
+        throw std::bad_alloc();
+    }
+}
+
+// The array and nothrow forms forward to these two
+void *operator new(std::size_t size) { return countedAlloc(size); }
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+namespace BenchAlloc
+{
+    Totals totals()
+    {
+        Totals t;
+        t.count = allocCount.load(std::memory_order_relaxed);
+        t.bytes = allocBytes.load(std::memory_order_relaxed);
+        return t;
+    }
+
+    void report(benchmark::State &state, const Totals &start)
+    {
+        const Totals end = totals();
+        const double iterations = static_cast<double>(state.iterations() ? state.iterations() : 1);
+        state.counters["allocs"] = static_cast<double>(end.count - start.count) / iterations;
+        state.counters["alloc_bytes"] = benchmark::Counter(static_cast<double>(end.bytes - start.bytes) / iterations,
+                                                           benchmark::Counter::kDefaults, benchmark::Counter::kIs1024);
+    }
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include <benchmark/benchmark.h>
+#include <cstdint>
+
+// Heap allocation counters for the benchmark binary (global operator new is
+// replaced in AllocCounter.cpp). Read them before the timed loop, then report().
+namespace BenchAlloc
+{
+    struct Totals
+    {
+        uint64_t count = 0;
+        uint64_t bytes = 0;
+    };
+
+    Totals totals();
+
+    // Adds "allocs" and "alloc_bytes" counters: allocations per iteration since `start`
+    void report(benchmark::State &state, const Totals &start);
+}
@@ -0,0 +1,75 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include <spdlog/spdlog.h>
+#include "Backtest.h"
+#include "BenchData.h"
+#include "MarketStructure.h"
+#include "Strategy.h"
+
+namespace
+{
+    // A limit order every `every` bars, alternating sides, with 1:2 stop/target distances
+    std::vector<Order> syntheticOrders(const CandleSeries &candles, size_t every)
+    {
+        std::vector<Order> orders;
+        for (size_t i = 0; i < candles.size(); i += every)
+        {
+            const double entry = candles.close[i];
+            const double risk = entry * 0.004;
+            if ((i / every) % 2 == 0)
+                orders.emplace_back(Order::Type::BUY, entry, candles.timestamp[i], entry - risk, entry + 2 * risk);
+            else
+                orders.emplace_back(Order::Type::SELL, entry, candles.timestamp[i], entry + risk, entry - 2 * risk);
+        }
+        return orders;
+    }
+}
+
+// Detection-free path: orders are generated up front, only the fill simulation is timed
+static void BM_Backtest(benchmark::State &state)
+{
+    const size_t bars = static_cast<size_t>(state.range(0));
+    const size_t every = static_cast<size_t>(state.range(1));
+    const CandleSeries candles = BenchData::randomWalkSeries(bars);
+    const std::vector<Order> orders = syntheticOrders(candles, every);
+    const Backtest backtest;
+
+    size_t trades = 0;
+    for (auto _ : state)
+    {
+        BacktestResult result = backtest.run(candles, orders);
+        trades = result.trades.size();
+        benchmark::DoNotOptimize(result.equity.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(bars));
+    state.counters["trades"] = static_cast<double>(trades);
+}
+BENCHMARK(BM_Backtest)
+    ->ArgsProduct({{1000000, 10000000}, {20, 200}})
+    ->Unit(benchmark::kMillisecond);
+
+// Strategy-driven path: order-block detection, structure confirmation and order
+// generation (logging off), then the fill simulation
+static void BM_BacktestStrategy(benchmark::State &state)
+{
+    const size_t bars = static_cast<size_t>(state.range(0));
+    const CandleSeries candles = BenchData::randomWalkSeries(bars);
+    const auto swings = detectSwingPoints(candles);
+    const auto choch = detectCHoCH(candles, swings);
+    const auto bos = detectBOS(candles, swings);
+    const Backtest backtest;
+    spdlog::logger quiet("quiet");
+    quiet.set_level(spdlog::level::off);
+
+    size_t trades = 0;
+    for (auto _ : state)
+    {
+        Strategy strategy(candles, swings, choch, bos, 2, &quiet);
+        BacktestResult result = backtest.run(candles, strategy);
+        trades = result.trades.size();
+        benchmark::DoNotOptimize(result.equity.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(bars));
+    state.counters["trades"] = static_cast<double>(trades);
+}
+BENCHMARK(BM_BacktestStrategy)->Arg(1000000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,75 @@
+#include <cstdio>
+#include <spdlog/spdlog.h>
+#include "Backtest.h"
+#include "BenchData.h"
+#include "MarketStructure.h"
+#include "Strategy.h"
+
+// No look-ahead in strategy backtests: every trade must come from an order the
+// strategy also generates when it only sees the bars before the fill. Exits
+// nonzero when a fill needed bars that had not happened yet.
+namespace
+{
+    std::vector<Order> strategyOrders(const CandleSeries &candles, int lookback, spdlog::logger &quiet)
+    {
+        const auto swings = detectSwingPoints(candles, lookback);
+        const auto choch = detectCHoCH(candles, swings);
+        const auto bos = detectBOS(candles, swings);
+        Strategy strategy(candles, swings, choch, bos, lookback, &quiet);
+        strategy.run();
+        return strategy.getOrders();
+    }
+
+    bool sameOrder(const Order &order, const Trade &trade)
+    {
+        return order.getType() == trade.type && order.getStopLoss() == trade.stopLoss &&
+               order.getTakeProfit() == trade.takeProfit;
+    }
+}
+
+int main()
+{
+    spdlog::logger quiet("quiet");
+    quiet.set_level(spdlog::level::off);
+
+    size_t trades = 0, failures = 0;
+    for (uint64_t seed : {3u, 7u})
+    {
+        const CandleSeries candles = BenchData::randomWalkSeries(1500, seed);
+        for (int lookback : {2, 3, 5})
+        {
+            const auto swings = detectSwingPoints(candles, lookback);
+            const auto choch = detectCHoCH(candles, swings);
+            const auto bos = detectBOS(candles, swings);
+            Strategy strategy(candles, swings, choch, bos, lookback, &quiet);
+            const BacktestResult result = Backtest().run(candles, strategy);
+
+            for (const auto &trade : result.trades)
+            {
+                ++trades;
+                CandleSeries seen;
+                for (size_t i = 0; i < trade.entryIndex; ++i)
+                    seen.push_back(candles.at(i));
+
+                bool known = false;
+                for (const auto &order : strategyOrders(seen, lookback, quiet))
+                    known = known || sameOrder(order, trade);
+                if (!known)
+                {
+                    std::printf("seed %llu, lookback %d: trade filled at bar %zu before its order was known\n",
+                                static_cast<unsigned long long>(seed), lookback, trade.entryIndex);
+                    ++failures;
+                }
+            }
+        }
+    }
+
+    std::printf("%zu trades checked\n", trades);
+    if (trades == 0)
+    {
+        std::printf("backtest causality FAILED: no trades to check\n");
+        return 1;
+    }
+    std::printf("%s\n", failures ? "backtest causality FAILED" : "backtest causality ok");
+    return failures ? 1 : 0;
+}
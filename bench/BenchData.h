@@ -0,0 +1,115 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <spdlog/spdlog.h>
+#include "Candle.h"
+#include "CandleSeries.h"
+#include "DataReader.h"
+
+namespace BenchData
+{
+    // Deterministic random-walk OHLC series (hourly bars) for benchmarks
+    inline std::vector<Candle> randomWalk(size_t bars, uint64_t seed = 42)
+    {
+        std::mt19937_64 rng(seed);
+        std::normal_distribution<double> step(0.0, 0.002);
+        std::exponential_distribution<double> wick(800.0);
+
+        std::vector<Candle> candles;
+        candles.reserve(bars);
+
+        double price = 1.25;
+        int64_t timestamp = 1577836800; // 2020-01-01 00:00:00
+        for (size_t i = 0; i < bars; ++i)
+        {
+            double open = price;
+            price *= std::exp(step(rng));
+            double high = std::max(open, price) + wick(rng);
+            double low = std::min(open, price) - wick(rng);
+            candles.emplace_back(open, high, low, price, 0, timestamp, (price - open) / open * 100.0);
+            timestamp += 3600;
+        }
+        return candles;
+    }
+
+    // DataReader logs a line per load; keep it (and anything else on stdout) out of the benchmark report
+    struct QuietStdout
+    {
+        std::streambuf *saved = std::cout.rdbuf(nullptr);
+        spdlog::level::level_enum savedLevel = spdlog::default_logger_raw()->level();
+        QuietStdout() { spdlog::default_logger_raw()->set_level(spdlog::level::off); }
+        ~QuietStdout()
+        {
+            spdlog::default_logger_raw()->set_level(savedLevel);
+            std::cout.rdbuf(saved);
+        }
+    };
+
+    inline CandleSeries randomWalkSeries(size_t bars, uint64_t seed = 42)
+    {
+        return CandleSeries(randomWalk(bars, seed));
+    }
+
+    // Candles from one of the files in data/ (empty if it cannot be read)
+    inline CandleSeries realSeries(const std::string &file)
+    {
+        QuietStdout quiet;
+        DataReader reader(std::string(TRADING_SYSTEM_DATA_DIR) + "/" + file, "CSV");
+        return reader.readSeries();
+    }
+
+    // `bars` bars made by repeating `base` back to back, every other copy played in
+    // reverse (each bar's open and close swapped), so consecutive copies join without
+    // a gap and the price stays in the range of the real data at any length.
+    inline CandleSeries tiledSeries(const CandleSeries &base, size_t bars)
+    {
+        CandleSeries out;
+        if (base.empty())
+            return out;
+        out.reserve(bars);
+
+        const size_t n = base.size();
+        const int64_t step = n > 1 ? (base.timestamp.back() - base.timestamp.front()) / static_cast<int64_t>(n - 1) : 3600;
+        int64_t timestamp = base.timestamp.front();
+        for (size_t copy = 0; out.size() < bars; ++copy)
+        {
+            const bool reversed = copy % 2 == 1;
+            for (size_t k = 0; k < n && out.size() < bars; ++k)
+            {
+                const size_t i = reversed ? n - 1 - k : k;
+                const double open = reversed ? base.close[i] : base.open[i];
+                const double close = reversed ? base.open[i] : base.close[i];
+                out.push_back(Candle(open, base.high[i], base.low[i], close, base.volume[i], timestamp,
+                                     open != 0 ? (close - open) / open * 100.0 : 0.0));
+                timestamp += step;
+            }
+        }
+        return out;
+    }
+
+    // Binance kline response for bars [first, last) of `candles`:
+    // [[openMs,"open","high","low","close","volume",closeMs,...],...]
+    inline std::string klineJSON(const CandleSeries &candles, size_t first = 0, size_t last = SIZE_MAX)
+    {
+        std::ostringstream out;
+        out.precision(10);
+        out << '[';
+        for (size_t i = first; i < std::min(last, candles.size()); ++i)
+        {
+            const int64_t openMs = candles.timestamp[i] * 1000;
+            if (i > first)
+                out << ',';
+            out << '[' << openMs << ",\"" << candles.open[i] << "\",\"" << candles.high[i] << "\",\"" << candles.low[i]
+                << "\",\"" << candles.close[i] << "\",\"" << candles.volume[i] << "\"," << openMs + 3599999
+                << ",\"0\",100,\"0\",\"0\",\"0\"]";
+        }
+        out << ']';
+        return out.str();
+    }
+}
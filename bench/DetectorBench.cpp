@@ -0,0 +1,177 @@
+#include <benchmark/benchmark.h>
+#include <map>
+#include <string>
+#include <vector>
+#include "AllocCounter.h"
+#include "BenchData.h"
+#include "MarketStructure.h"
+#include "OrderBlock.h"
+
+// Every batch detector over 1k to 10M bars, on a synthetic random walk and on the
+// files in data/ (tiled to length, see BenchData::tiledSeries). items_per_second is
+// bars/s; allocs and alloc_bytes are heap allocations per call.
+//
+// The all-pairs detectTrendlineBreak is roughly cubic; it stays in TrendlineBench
+// on small series.
+
+namespace
+{
+    // nullptr = synthetic random walk, otherwise a file in data/
+    const CandleSeries &series(benchmark::State &state, const char *file)
+    {
+        static std::map<std::string, CandleSeries> bases;
+        static std::string cachedFile;
+        static size_t cachedBars = 0;
+        static CandleSeries cached;
+
+        const size_t bars = static_cast<size_t>(state.range(0));
+        const std::string key = file ? file : "";
+        if (key != cachedFile || bars != cachedBars || cached.empty())
+        {
+            cached = CandleSeries();  // release the previous series before building the next
+            if (file)
+            {
+                auto it = bases.find(key);
+                if (it == bases.end())
+                    it = bases.emplace(key, BenchData::realSeries(key)).first;
+                cached = BenchData::tiledSeries(it->second, bars);
+            }
+            else
+            {
+                cached = BenchData::randomWalkSeries(bars);
+            }
+            cachedFile = key;
+            cachedBars = bars;
+        }
+        if (cached.empty())
+            state.SkipWithError("could not load candles");
+        return cached;
+    }
+
+    void finish(benchmark::State &state, const BenchAlloc::Totals &start)
+    {
+        BenchAlloc::report(state, start);
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void allSizes(benchmark::internal::Benchmark *b)
+    {
+        b->RangeMultiplier(10)->Range(1000, 10000000)->Unit(benchmark::kMillisecond);
+    }
+}
+
+static void BM_SwingPoints(benchmark::State &state, const char *file)
+{
+    const CandleSeries &candles = series(state, file);
+    size_t swings = 0;
+
+    const BenchAlloc::Totals start = BenchAlloc::totals();
+    for (auto _ : state)
+    {
+        auto points = detectSwingPoints(candles);
+        swings = points.size();
+        benchmark::DoNotOptimize(points.data());
+    }
+    finish(state, start);
+    state.counters["swings"] = static_cast<double>(swings);
+}
+
+static void BM_BOS(benchmark::State &state, const char *file)
+{
+    const CandleSeries &candles = series(state, file);
+    const auto swings = detectSwingPoints(candles);
+    size_t events = 0;
+
+    const BenchAlloc::Totals start = BenchAlloc::totals();
+    for (auto _ : state)
+    {
+        auto points = detectBOS(candles, swings);
+        events = points.size();
+        benchmark::DoNotOptimize(points.data());
+    }
+    finish(state, start);
+    state.counters["events"] = static_cast<double>(events);
+}
+
+static void BM_CHoCH(benchmark::State &state, const char *file)
+{
+    const CandleSeries &candles = series(state, file);
+    const auto swings = detectSwingPoints(candles);
+    size_t events = 0;
+
+    const BenchAlloc::Totals start = BenchAlloc::totals();
+    for (auto _ : state)
+    {
+        auto points = detectCHoCH(candles, swings);
+        events = points.size();
+        benchmark::DoNotOptimize(points.data());
+    }
+    finish(state, start);
+    state.counters["events"] = static_cast<double>(events);
+}
+
+static void BM_TrendlineBreaks(benchmark::State &state, const char *file)
+{
+    const CandleSeries &candles = series(state, file);
+    const auto swings = detectSwingPoints(candles);
+    size_t events = 0;
+
+    const BenchAlloc::Totals start = BenchAlloc::totals();
+    for (auto _ : state)
+    {
+        auto points = detectBoundedTrendlineBreaks(candles, swings);
+        events = points.size();
+        benchmark::DoNotOptimize(points.data());
+    }
+    finish(state, start);
+    state.counters["events"] = static_cast<double>(events);
+}
+
+static void BM_OrderBlocks(benchmark::State &state, const char *file)
+{
+    const CandleSeries &candles = series(state, file);
+    size_t blocks = 0;
+
+    const BenchAlloc::Totals start = BenchAlloc::totals();
+    for (auto _ : state)
+    {
+        auto obs = detectOrderBlocks(candles);
+        blocks = obs.size();
+        benchmark::DoNotOptimize(obs.data());
+    }
+    finish(state, start);
+    state.counters["order_blocks"] = static_cast<double>(blocks);
+}
+
+static void BM_FilterOrderBlocks(benchmark::State &state, const char *file)
+{
+    const CandleSeries &candles = series(state, file);
+    const auto swings = detectSwingPoints(candles);
+    const auto bos = detectBOS(candles, swings);
+    const auto choch = detectCHoCH(candles, swings);
+    const auto obs = detectOrderBlocks(candles);
+    size_t confirmed = 0;
+
+    const BenchAlloc::Totals start = BenchAlloc::totals();
+    for (auto _ : state)
+    {
+        auto result = filterOrderBlocksWithStructure(candles, obs, choch, bos);
+        confirmed = result.size();
+        benchmark::DoNotOptimize(result.data());
+    }
+    finish(state, start);
+    state.counters["confirmed"] = static_cast<double>(confirmed);
+}
+
+#define DETECTOR_BENCHMARK(fn, sizes)                                             \
+    BENCHMARK_CAPTURE(fn, synthetic, nullptr)->Apply(sizes);                      \
+    BENCHMARK_CAPTURE(fn, XAUUSD, "XAUUSD_historical_data.csv")->Apply(sizes);    \
+    BENCHMARK_CAPTURE(fn, GBPUSD, "GBPUSD_historical_data.csv")->Apply(sizes);    \
+    BENCHMARK_CAPTURE(fn, USDJPY, "USDJPY_historical_data.csv")->Apply(sizes)
+
+DETECTOR_BENCHMARK(BM_SwingPoints, allSizes);
+DETECTOR_BENCHMARK(BM_BOS, allSizes);
+DETECTOR_BENCHMARK(BM_CHoCH, allSizes);
+DETECTOR_BENCHMARK(BM_TrendlineBreaks, allSizes);
+DETECTOR_BENCHMARK(BM_OrderBlocks, allSizes);
+DETECTOR_BENCHMARK(BM_FilterOrderBlocks, allSizes);
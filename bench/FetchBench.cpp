@@ -0,0 +1,194 @@
+#include <benchmark/benchmark.h>
+#include <curl/curl.h>
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <string>
+#include <vector>
+#include "BenchData.h"
+#include "DataReader.h"
+#include "KlineFetcher.h"
+#include "KlineParser.h"
+#include "LocalHttpServer.h"
+#include "json.hpp"
+
+namespace
+{
+    constexpr int kLatencyMs = 5; // per-response server delay, a stand-in for network round trips
+
+    // 1000 klines, the size of a full Binance page
+    const std::string &klineBody()
+    {
+        static const std::string body = BenchData::klineJSON(BenchData::randomWalkSeries(1000));
+        return body;
+    }
+
+    // The previous parser: a full nlohmann::json DOM, then get<std::string>() and std::stod per field
+    bool parseDOM(const std::string &body, std::vector<Candle> &out)
+    {
+        std::vector<Candle> candles;
+        try
+        {
+            const nlohmann::json j = nlohmann::json::parse(body);
+            for (const auto &entry : j)
+            {
+                if (entry.size() < 6)
+                    continue;
+                Candle candle;
+                candle.timestamp = entry[0].get<long long>() / 1000;
+                candle.open = std::stod(entry[1].get<std::string>());
+                candle.high = std::stod(entry[2].get<std::string>());
+                candle.low = std::stod(entry[3].get<std::string>());
+                candle.close = std::stod(entry[4].get<std::string>());
+                candle.volume = std::stod(entry[5].get<std::string>());
+                candle.changePercent = ((candle.close - candle.open) / candle.open) * 100.0;
+                candles.push_back(candle);
+            }
+            std::sort(candles.begin(), candles.end(), [](const Candle &a, const Candle &b)
+                      { return a.timestamp < b.timestamp; });
+        }
+        catch (const std::exception &)
+        {
+            return false;
+        }
+        out = std::move(candles);
+        return true;
+    }
+
+    size_t appendBody(void *contents, size_t size, size_t nmemb, void *userp)
+    {
+        static_cast<std::string *>(userp)->append(static_cast<char *>(contents), size * nmemb);
+        return size * nmemb;
+    }
+
+    // The previous API path: a new easy handle (and connection) per symbol, one after another
+    bool fetchFresh(const std::string &url, std::vector<Candle> &out)
+    {
+        CURL *curl = curl_easy_init();
+        std::string body;
+        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, appendBody);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &body);
+        const CURLcode res = curl_easy_perform(curl);
+        curl_easy_cleanup(curl);
+        return res == CURLE_OK && KlineParser::parse(body, out);
+    }
+}
+
+static void BM_Fetch_SequentialFreshHandles(benchmark::State &state)
+{
+    const size_t symbols = static_cast<size_t>(state.range(0));
+    LocalHttpServer server(klineBody(), kLatencyMs);
+
+    std::vector<Candle> candles;
+    for (auto _ : state)
+    {
+        for (size_t s = 0; s < symbols; ++s)
+        {
+            if (!fetchFresh(server.url("/api/v3/klines?symbol=SYM" + std::to_string(s)), candles))
+                state.SkipWithError("fetch failed");
+            benchmark::DoNotOptimize(candles.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(symbols));
+    state.counters["connections"] = static_cast<double>(server.connectionCount());
+}
+BENCHMARK(BM_Fetch_SequentialFreshHandles)->Arg(1)->Arg(8)->Arg(32)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_Fetch_KlineFetcher(benchmark::State &state)
+{
+    const size_t symbols = static_cast<size_t>(state.range(0));
+    LocalHttpServer server(klineBody(), kLatencyMs);
+
+    KlineFetcher fetcher;
+    for (size_t s = 0; s < symbols; ++s)
+        fetcher.add(server.url("/api/v3/klines?symbol=SYM" + std::to_string(s)));
+
+    size_t failed = 0;
+    for (auto _ : state)
+    {
+        fetcher.fetchAll([&](size_t, std::vector<Candle> &&candles, bool ok)
+                         {
+                             failed += ok ? 0 : 1;
+                             benchmark::DoNotOptimize(candles.data());
+                         });
+    }
+    if (failed > 0)
+        state.SkipWithError("fetch failed");
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(symbols));
+    state.counters["connections"] = static_cast<double>(server.connectionCount());
+}
+BENCHMARK(BM_Fetch_KlineFetcher)->Arg(1)->Arg(8)->Arg(32)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// Parsing one response of N klines; items/s is klines per second
+static void BM_ParseKlines_DOM(benchmark::State &state)
+{
+    const std::string body = BenchData::klineJSON(BenchData::randomWalkSeries(static_cast<size_t>(state.range(0))));
+    std::vector<Candle> candles;
+    for (auto _ : state)
+    {
+        if (!parseDOM(body, candles))
+            state.SkipWithError("parse failed");
+        benchmark::DoNotOptimize(candles.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(body.size()));
+}
+BENCHMARK(BM_ParseKlines_DOM)->Arg(100)->Arg(1000)->Unit(benchmark::kMicrosecond);
+
+static void BM_ParseKlines_Streaming(benchmark::State &state)
+{
+    const std::string body = BenchData::klineJSON(BenchData::randomWalkSeries(static_cast<size_t>(state.range(0))));
+    std::vector<Candle> candles;
+    for (auto _ : state)
+    {
+        if (!KlineParser::parse(body, candles))
+            state.SkipWithError("parse failed");
+        benchmark::DoNotOptimize(candles.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(body.size()));
+}
+BENCHMARK(BM_ParseKlines_Streaming)->Arg(100)->Arg(1000)->Unit(benchmark::kMicrosecond);
+
+// One readAPI cycle against an endpoint serving 1000 hourly klines, where only the
+// forming last bar changes between cycles: the whole page every time, or only the
+// bars after the cache (arg 1). bytes/cycle is the response payload.
+static void BM_ReadAPI_Cycle(benchmark::State &state)
+{
+    const bool cached = state.range(0) != 0;
+    CandleSeries market = BenchData::randomWalkSeries(1000);
+    // Ending at the current hour, so the cache is never more than a page behind
+    const int64_t shift = (static_cast<int64_t>(std::time(nullptr)) / 3600) * 3600 - market.timestamp.back();
+    for (auto &timestamp : market.timestamp)
+        timestamp += shift;
+    const std::string cacheDir = "/tmp/TradingSystemBench_klines";
+    std::remove((cacheDir + "/BENCH_1h.bin").c_str());
+
+    LocalHttpServer server([&](const std::string &target)
+                           {
+                               // startTime (ms) selects the bars from that open time on
+                               const size_t at = target.find("startTime=");
+                               size_t first = 0;
+                               if (at != std::string::npos)
+                               {
+                                   const int64_t start = std::stoll(target.substr(at + 10)) / 1000;
+                                   first = static_cast<size_t>(std::lower_bound(market.timestamp.begin(), market.timestamp.end(), start) - market.timestamp.begin());
+                               }
+                               return BenchData::klineJSON(market, first);
+                           });
+
+    BenchData::QuietStdout quiet;
+    DataReader reader("", "API", server.url("/api/v3/klines?symbol=BENCH&interval=1h&limit=1000"), "", "stream",
+                      cached ? cacheDir : "");
+    reader.readSeries(); // fills the cache
+
+    const size_t before = server.bodyBytes();
+    for (auto _ : state)
+    {
+        CandleSeries candles = reader.readSeries();
+        benchmark::DoNotOptimize(candles.close.data());
+    }
+    state.counters["bytes/cycle"] = static_cast<double>(server.bodyBytes() - before) / static_cast<double>(state.iterations());
+}
+BENCHMARK(BM_ReadAPI_Cycle)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond)->UseRealTime();
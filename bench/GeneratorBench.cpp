@@ -0,0 +1,39 @@
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <string>
+#include "MarketGenerator.h"
+
+// In-memory generation straight into CandleSeries columns, per model
+static void BM_Generate(benchmark::State &state, MarketModel model)
+{
+    GeneratorConfig config;
+    config.model = model;
+    const size_t bars = static_cast<size_t>(state.range(0));
+
+    for (auto _ : state)
+    {
+        CandleSeries series = generateSeries(config, bars);
+        benchmark::DoNotOptimize(series.close.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(bars));
+}
+BENCHMARK_CAPTURE(BM_Generate, random_walk, MarketModel::RandomWalk)->Arg(10000000)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Generate, gbm, MarketModel::GBM)->Arg(10000000)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Generate, regime, MarketModel::RegimeSwitching)->Arg(10000000)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Generate, trend, MarketModel::TrendWithPullbacks)->Arg(10000000)->Unit(benchmark::kMillisecond);
+
+// Generation plus CSV formatting and the newest-first file layout
+static void BM_GenerateCSV(benchmark::State &state)
+{
+    const size_t bars = static_cast<size_t>(state.range(0));
+    const std::string path = "/tmp/TradingSystemBench_generated.csv";
+
+    for (auto _ : state)
+    {
+        if (!writeGeneratedCSV(path, GeneratorConfig(), bars))
+            state.SkipWithError("could not write CSV");
+    }
+    std::remove(path.c_str());
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(bars));
+}
+BENCHMARK(BM_GenerateCSV)->Arg(1000000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,116 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "BenchData.h"
+#include "Indicators.h"
+#include "TradingUtils.h"
+
+namespace
+{
+    // The scalar loop TradingUtils and ParameterSweep used per bar
+    void scalarTrueRange(const CandleSeries &candles, std::vector<double> &out)
+    {
+        out.assign(candles.size(), 0.0);
+        for (size_t i = 1; i < candles.size(); ++i)
+        {
+            const double prevClose = candles.close[i - 1];
+            out[i] = std::max({candles.high[i] - candles.low[i], std::fabs(candles.high[i] - prevClose),
+                               std::fabs(candles.low[i] - prevClose)});
+        }
+    }
+}
+
+// True range of every bar; items/s is bars per second
+static void BM_TrueRange_Scalar(benchmark::State &state)
+{
+    const CandleSeries candles = BenchData::randomWalkSeries(static_cast<size_t>(state.range(0)));
+    std::vector<double> out;
+    for (auto _ : state)
+    {
+        scalarTrueRange(candles, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TrueRange_Scalar)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMicrosecond);
+
+static void BM_TrueRange_Kernel(benchmark::State &state)
+{
+    const CandleSeries candles = BenchData::randomWalkSeries(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        std::vector<double> out = Indicators::trueRange(candles);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TrueRange_Kernel)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMicrosecond);
+
+// ATR(14) at every bar: calculateATR on each prefix (what a caller had to do before)
+// against one atrSeries pass
+static void BM_ATR_PerBarCalculateATR(benchmark::State &state)
+{
+    const CandleSeries candles = BenchData::randomWalkSeries(static_cast<size_t>(state.range(0)));
+    std::vector<double> atr(candles.size());
+    for (auto _ : state)
+    {
+        for (size_t i = 14; i < candles.size(); ++i)
+        {
+            const size_t first = i - 13;
+            double sum = 0.0;
+            for (size_t b = first; b <= i; ++b)
+            {
+                const double prevClose = candles.close[b - 1];
+                sum += std::max({candles.high[b] - candles.low[b], std::fabs(candles.high[b] - prevClose),
+                                 std::fabs(candles.low[b] - prevClose)});
+            }
+            atr[i] = sum / 14.0;
+        }
+        benchmark::DoNotOptimize(atr.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ATR_PerBarCalculateATR)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMicrosecond);
+
+static void BM_ATR_Series(benchmark::State &state)
+{
+    const CandleSeries candles = BenchData::randomWalkSeries(static_cast<size_t>(state.range(0)));
+    const auto method = state.range(1) ? Indicators::ATRMethod::Wilder : Indicators::ATRMethod::Simple;
+    for (auto _ : state)
+    {
+        std::vector<double> atr = Indicators::atrSeries(candles, 14, method);
+        benchmark::DoNotOptimize(atr.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ATR_Series)->Args({100000, 0})->Args({100000, 1})->Args({1000000, 0})->Args({1000000, 1})->Unit(benchmark::kMicrosecond);
+
+// One live bar: the tracker's O(1) push against calculateATR over the grown series
+static void BM_ATR_LiveBar(benchmark::State &state)
+{
+    const bool tracker = state.range(0) != 0;
+    const CandleSeries candles = BenchData::randomWalkSeries(100000);
+    Indicators::ATRTracker live(14);
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        double atr;
+        if (tracker)
+        {
+            atr = live.push(candles.high[i], candles.low[i], candles.close[i]);
+        }
+        else
+        {
+            atr = TradingUtils::calculateATR(candles, 14);
+        }
+        benchmark::DoNotOptimize(atr);
+        if (++i == candles.size())
+        {
+            i = 0;
+            live.reset();
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ATR_LiveBar)->Arg(0)->Arg(1);
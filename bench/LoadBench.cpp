@@ -0,0 +1,69 @@
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include "BenchData.h"
+#include "CandleStore.h"
+#include "DataReader.h"
+#include "Utils.h"
+
+namespace
+{
+    // Write a synthetic history in the data/ CSV layout (newest row first)
+    std::string writeCSV(size_t bars)
+    {
+        const std::string path = "/tmp/TradingSystemBench_" + std::to_string(bars) + ".csv";
+        const auto candles = BenchData::randomWalk(bars);
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << "BENCH Historical Data\r\nDate,Open,High,Low,Close,Change(Pips),Change(%)\r\n";
+        char line[160];
+        for (size_t i = candles.size(); i-- > 0;)
+        {
+            const Candle &c = candles[i];
+            // data/ files use MM/DD/YYYY HH:MM
+            const std::string iso = Utils::formatTimestamp(c.timestamp);
+            const std::string date = iso.substr(5, 2) + "/" + iso.substr(8, 2) + "/" + iso.substr(0, 4) + " " + iso.substr(11, 5);
+            std::snprintf(line, sizeof(line), "%s,%.5f,%.5f,%.5f,%.5f,%.1f,%.2f,\r\n",
+                          date.c_str(), c.open, c.high, c.low, c.close, (c.close - c.open) * 1e4, c.changePercent);
+            out << line;
+        }
+        return path;
+    }
+
+    std::string writeStore(const std::string &csvPath, size_t bars)
+    {
+        const std::string path = "/tmp/TradingSystemBench_" + std::to_string(bars) + ".bin";
+        DataReader reader(csvPath, "CSV", "", "", "mmap");
+        reader.exportBinary(path, "BENCH", "1h");
+        return path;
+    }
+}
+
+static void BM_Load(benchmark::State &state, const char *source, const char *csvReader)
+{
+    BenchData::QuietStdout quiet;
+    const size_t bars = static_cast<size_t>(state.range(0));
+    const std::string csvPath = writeCSV(bars);
+    const std::string path = std::string(source) == "BIN" ? writeStore(csvPath, bars) : csvPath;
+
+    DataReader reader(path, source, "", "", csvReader);
+    for (auto _ : state)
+    {
+        CandleSeries candles = reader.readSeries();
+        if (candles.size() != bars)
+        {
+            state.SkipWithError("unexpected bar count");
+            break;
+        }
+        benchmark::DoNotOptimize(candles.close.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(bars));
+
+    std::remove(csvPath.c_str());
+    if (path != csvPath)
+        std::remove(path.c_str());
+}
+BENCHMARK_CAPTURE(BM_Load, csv_stream, "CSV", "stream")->RangeMultiplier(10)->Range(10000, 1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Load, csv_mmap, "CSV", "mmap")->RangeMultiplier(10)->Range(10000, 1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Load, binary, "BIN", "")->RangeMultiplier(10)->Range(10000, 1000000)->Unit(benchmark::kMillisecond);
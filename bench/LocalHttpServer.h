@@ -0,0 +1,165 @@
+#pragma once
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Minimal HTTP/1.1 stand-in for a kline endpoint: listens on 127.0.0.1 (ephemeral
+// port), answers every GET with a canned JSON body (or whatever a responder returns
+// for the request target) and keeps connections alive, so fetch paths can be
+// measured and checked without the network. One thread per connection; `delayMs`
+// simulates server latency per response.
+class LocalHttpServer
+{
+public:
+    // Body for a request target such as "/api/v3/klines?symbol=X&startTime=..."
+    using Responder = std::function<std::string(const std::string &target)>;
+
+private:
+    int listenFd = -1;
+    int listenPort = 0;
+    Responder respond;
+    int delayMs;
+    std::atomic<size_t> bytesServed{0};
+    std::atomic<bool> stopping{false};
+    std::atomic<size_t> connections{0};
+    std::thread acceptor;
+    std::mutex clientsMutex;
+    std::vector<int> clientFds;
+    std::vector<std::thread> clients;
+
+    void acceptLoop()
+    {
+        while (!stopping.load())
+        {
+            const int fd = ::accept(listenFd, nullptr, nullptr);
+            if (fd < 0)
+                continue;
+
+            std::lock_guard<std::mutex> lock(clientsMutex);
+            if (stopping.load())
+            {
+                ::close(fd);
+                break;
+            }
+            connections.fetch_add(1);
+            clientFds.push_back(fd);
+            clients.emplace_back([this, fd]() { serve(fd); });
+        }
+    }
+
+    void serve(int fd)
+    {
+        std::string request;
+        char buffer[4096];
+        for (;;)
+        {
+            // One response per complete request head
+            size_t end;
+            while ((end = request.find("\r\n\r\n")) == std::string::npos)
+            {
+                const ssize_t n = ::recv(fd, buffer, sizeof(buffer), 0);
+                if (n <= 0)
+                    return;
+                request.append(buffer, static_cast<size_t>(n));
+            }
+            // "GET <target> HTTP/1.1"
+            const size_t targetStart = request.find(' ') + 1;
+            const std::string target = request.substr(targetStart, request.find(' ', targetStart) - targetStart);
+            request.erase(0, end + 4);
+
+            // Header and body in one write, so small responses are not held back by Nagle
+            const std::string body = respond(target);
+            const std::string response = "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: " +
+                                         std::to_string(body.size()) + "\r\nConnection: keep-alive\r\n\r\n" + body;
+            if (delayMs > 0)
+                std::this_thread::sleep_for(std::chrono::milliseconds(delayMs));
+            if (!sendAll(fd, response))
+                return;
+            bytesServed.fetch_add(body.size());
+        }
+    }
+
+    static bool sendAll(int fd, const std::string &data)
+    {
+        size_t sent = 0;
+        while (sent < data.size())
+        {
+            const ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+            if (n <= 0)
+                return false;
+            sent += static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+public:
+    explicit LocalHttpServer(std::string responseBody, int delayMs = 0)
+        : LocalHttpServer([body = std::move(responseBody)](const std::string &) { return body; }, delayMs)
+    {
+    }
+
+    explicit LocalHttpServer(Responder responder, int delayMs = 0)
+        : respond(std::move(responder)), delayMs(delayMs)
+    {
+        listenFd = ::socket(AF_INET, SOCK_STREAM, 0);
+        const int yes = 1;
+        ::setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        socklen_t length = sizeof(addr);
+        if (listenFd < 0 || ::bind(listenFd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0 ||
+            ::listen(listenFd, 128) != 0 || ::getsockname(listenFd, reinterpret_cast<sockaddr *>(&addr), &length) != 0)
+        {
+            if (listenFd >= 0)
+                ::close(listenFd);
+            throw std::runtime_error("LocalHttpServer: cannot listen on 127.0.0.1");
+        }
+        listenPort = ntohs(addr.sin_port);
+        acceptor = std::thread([this]() { acceptLoop(); });
+    }
+
+    ~LocalHttpServer()
+    {
+        stopping.store(true);
+        ::shutdown(listenFd, SHUT_RDWR);
+        acceptor.join();
+        ::close(listenFd);
+
+        std::lock_guard<std::mutex> lock(clientsMutex);
+        for (int fd : clientFds)
+            ::shutdown(fd, SHUT_RDWR);
+        for (auto &client : clients)
+            client.join();
+        for (int fd : clientFds)
+            ::close(fd);
+    }
+
+    LocalHttpServer(const LocalHttpServer &) = delete;
+    LocalHttpServer &operator=(const LocalHttpServer &) = delete;
+
+    int port() const { return listenPort; }
+
+    // e.g. "http://127.0.0.1:40123/api/v3/klines?symbol=SYM3"
+    std::string url(const std::string &path = "/api/v3/klines") const
+    {
+        return "http://127.0.0.1:" + std::to_string(listenPort) + path;
+    }
+
+    // TCP connections accepted so far (shows whether clients reuse them)
+    size_t connectionCount() const { return connections.load(); }
+
+    // Response body bytes sent so far
+    size_t bodyBytes() const { return bytesServed.load(); }
+};
@@ -0,0 +1,49 @@
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <spdlog/spdlog.h>
+#include <spdlog/sinks/basic_file_sink.h>
+#include "AsyncLog.h"
+
+// Cost of one log call on the calling thread when every line is written to a file
+// and flushed: synchronously, or handed to an AsyncLogQueue writer.
+
+namespace
+{
+    std::shared_ptr<spdlog::sinks::basic_file_sink_mt> fileSink()
+    {
+        auto sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>("/tmp/TradingSystemBench_log.txt", true);
+        sink->set_pattern("%l [%Y-%m-%d %H:%M:%S] [%n] %v");
+        return sink;
+    }
+
+    void logLines(benchmark::State &state, spdlog::logger &log)
+    {
+        log.flush_on(spdlog::level::info);
+        double entry = 1.2345;
+        for (auto _ : state)
+        {
+            log.info("[RiskManagement] Entry: {:.4f} BUY , ATR: {:.4f}, SL: {:.4f}, TP1: {:.4f}, TP2: {:.4f}",
+                     entry, 0.0042, entry - 0.0063, entry + 0.0063, entry + 0.0126);
+            entry += 1e-5;
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+}
+
+static void BM_Log_Sync(benchmark::State &state)
+{
+    spdlog::logger log("XAUUSD", fileSink());
+    logLines(state, log);
+}
+BENCHMARK(BM_Log_Sync);
+
+static void BM_Log_Async(benchmark::State &state, LogOverflow overflow)
+{
+    auto queue = std::make_shared<AsyncLogQueue>(static_cast<size_t>(state.range(0)), overflow);
+    spdlog::logger log("XAUUSD", std::make_shared<AsyncSink>(queue, fileSink()));
+    logLines(state, log);
+    queue->stop();
+    state.counters["dropped"] = static_cast<double>(queue->droppedCount());
+}
+BENCHMARK_CAPTURE(BM_Log_Async, block, LogOverflow::Block)->Arg(8192);
+BENCHMARK_CAPTURE(BM_Log_Async, drop, LogOverflow::Drop)->Arg(8192);
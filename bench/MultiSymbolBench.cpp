@@ -0,0 +1,56 @@
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <string>
+#include <spdlog/spdlog.h>
+#include "BenchData.h"
+#include "CandleStore.h"
+#include "MultiSymbolRunner.h"
+
+namespace
+{
+    constexpr size_t kSymbols = 64;
+
+    // One binary store per synthetic symbol, each with its own random walk
+    Config makeConfig(size_t bars, int threads)
+    {
+        Config config;
+        config.worker_threads = threads;
+        for (size_t s = 0; s < kSymbols; ++s)
+        {
+            const std::string symbol = "SYM" + std::to_string(s);
+            const std::string path = "/tmp/TradingSystemBench_" + symbol + "_" + std::to_string(bars) + ".bin";
+            CandleStore::write(path, BenchData::randomWalkSeries(bars, 1000 + s), symbol, "1h");
+            config.instruments.push_back({symbol, path, "BIN", "", ""});
+        }
+        return config;
+    }
+}
+
+// One full analysis cycle over 64 symbols; items/s should scale with the thread count
+static void BM_MultiSymbolCycle(benchmark::State &state)
+{
+    const size_t bars = static_cast<size_t>(state.range(0));
+    const int threads = static_cast<int>(state.range(1));
+
+    const auto level = spdlog::default_logger()->level();
+    spdlog::set_level(spdlog::level::off);
+    BenchData::QuietStdout quiet;
+
+    const Config config = makeConfig(bars, threads);
+    {
+        MultiSymbolRunner runner(config);
+        for (auto _ : state)
+        {
+            runner.runCycle();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kSymbols));
+
+    for (const auto &instrument : config.instruments)
+        std::remove(instrument.csv_path.c_str());
+    spdlog::set_level(level);
+}
+BENCHMARK(BM_MultiSymbolCycle)
+    ->ArgsProduct({{10000, 100000}, {1, 2, 4, 8}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
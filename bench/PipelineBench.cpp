@@ -0,0 +1,60 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include "BenchData.h"
+#include "DetectionPipeline.h"
+#include "StructureUtils.h"
+#include "TradingUtils.h"
+
+// What OrderBlockAnalyzer::analyze ran before the fused pipeline: one pass per detector
+static void BM_Analyze_Separate(benchmark::State &state)
+{
+    const size_t bars = static_cast<size_t>(state.range(0));
+    const CandleSeries candles = BenchData::randomWalkSeries(bars);
+
+    for (auto _ : state)
+    {
+        auto swings = detectSwingPoints(candles);
+        auto bos = detectBOS(candles, swings);
+        auto choch = detectCHoCH(candles, swings);
+        auto breaks = detectBoundedTrendlineBreaks(candles, swings);
+        auto events = StructureUtils::gatherStructureEvents(bos, choch, breaks, candles);
+        auto obs = detectOrderBlocks(candles);
+
+        double entry = 0.0;
+        if (!obs.empty())
+        {
+            const OBZone &zone = obs.back().first;
+            for (size_t i = 0; i < candles.size(); ++i)
+            {
+                if (candles.timestamp[i] > zone.timestamp && candles.close[i] >= std::min(zone.bottom, zone.top) &&
+                    candles.close[i] <= std::max(zone.bottom, zone.top))
+                {
+                    entry = candles.close[i];
+                    break;
+                }
+            }
+        }
+        double atr = TradingUtils::calculateATR(candles, 14);
+
+        benchmark::DoNotOptimize(events.data());
+        benchmark::DoNotOptimize(entry);
+        benchmark::DoNotOptimize(atr);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(bars));
+}
+BENCHMARK(BM_Analyze_Separate)->RangeMultiplier(10)->Range(100000, 10000000)->Unit(benchmark::kMillisecond);
+
+static void BM_Analyze_Fused(benchmark::State &state)
+{
+    const size_t bars = static_cast<size_t>(state.range(0));
+    const CandleSeries candles = BenchData::randomWalkSeries(bars);
+    DetectionPipeline pipeline = DetectionPipeline::standard();
+
+    for (auto _ : state)
+    {
+        PipelineResult result = pipeline.run(candles);
+        benchmark::DoNotOptimize(result.structureEvents.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(bars));
+}
+BENCHMARK(BM_Analyze_Fused)->RangeMultiplier(10)->Range(100000, 10000000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,62 @@
+#include <benchmark/benchmark.h>
+#include "BenchData.h"
+#include "ReplayCheck.h"
+
+using ReplayCheck::runBatch;
+
+// Replay check: after every appended bar the engine must equal the batch
+// pipeline over the same prefix. Fails the benchmark on the first mismatch.
+static void BM_Replay_Equivalence(benchmark::State &state)
+{
+    const size_t bars = static_cast<size_t>(state.range(0));
+    const size_t span = static_cast<size_t>(state.range(1));
+    const std::vector<Candle> data = BenchData::randomWalk(bars, 7);
+
+    for (auto _ : state)
+    {
+        size_t failedBar = 0;
+        const char *error = ReplayCheck::replay(data, span, failedBar);
+        if (*error)
+        {
+            state.SkipWithError(error);
+            return;
+        }
+    }
+}
+BENCHMARK(BM_Replay_Equivalence)->Args({2000, 1})->Args({2000, 4})->Unit(benchmark::kMillisecond)->Iterations(1);
+
+// Cost of one new bar: incremental append vs recomputing everything.
+// The engine is warmed up on `bars` bars, then each iteration appends the next one
+// Sizes avoid powers of two so the timed bars do not all land on a vector regrowth.
+static constexpr int64_t kNewBars = 1024;
+
+static void BM_NewBar_Incremental(benchmark::State &state)
+{
+    const size_t bars = static_cast<size_t>(state.range(0));
+    const std::vector<Candle> data = BenchData::randomWalk(bars + kNewBars);
+
+    IncrementalStructure engine;
+    for (size_t i = 0; i < bars; ++i)
+        engine.append(data[i]);
+
+    size_t next = bars;
+    for (auto _ : state)
+    {
+        engine.append(data[next++]);
+        benchmark::DoNotOptimize(engine.getStructureEvents().data());
+    }
+}
+BENCHMARK(BM_NewBar_Incremental)->Arg(1000)->Arg(10000)->Arg(100000)->Arg(1000000)->Iterations(kNewBars)->Unit(benchmark::kMicrosecond);
+
+static void BM_NewBar_FullRecompute(benchmark::State &state)
+{
+    const size_t bars = static_cast<size_t>(state.range(0));
+    const CandleSeries candles = BenchData::randomWalkSeries(bars + 1);
+
+    for (auto _ : state)
+    {
+        auto result = runBatch(candles, 1);
+        benchmark::DoNotOptimize(result.events.data());
+    }
+}
+BENCHMARK(BM_NewBar_FullRecompute)->Arg(1000)->Arg(10000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,37 @@
+#include <cstdio>
+#include "BenchData.h"
+#include "ReplayCheck.h"
+
+// Replay equivalence as a test: after every appended bar the incremental engine
+// must equal the batch pipeline over the same prefix, and it must see every BOS on
+// the bar bosKnownBars dates it to. Exits nonzero on a mismatch.
+int main()
+{
+    int failures = 0;
+    for (uint64_t seed : {7u, 11u})
+    {
+        const std::vector<Candle> data = BenchData::randomWalk(2000, seed);
+        for (size_t span : {1u, 4u})
+        {
+            size_t failedBar = 0;
+            const char *error = ReplayCheck::replay(data, span, failedBar);
+            if (*error)
+            {
+                std::printf("seed %llu, trendline span %zu: %s at bar %zu\n",
+                            static_cast<unsigned long long>(seed), span, error, failedBar);
+                ++failures;
+            }
+        }
+        for (int lookback : {2, 3, 5})
+        {
+            const char *error = ReplayCheck::bosTiming(data, lookback);
+            if (*error)
+            {
+                std::printf("seed %llu, lookback %d: %s\n", static_cast<unsigned long long>(seed), lookback, error);
+                ++failures;
+            }
+        }
+    }
+    std::printf("%s\n", failures ? "replay equivalence FAILED" : "replay equivalence ok");
+    return failures ? 1 : 0;
+}
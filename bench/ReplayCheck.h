@@ -0,0 +1,139 @@
+#pragma once
+#include <algorithm>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "CandleSeries.h"
+#include "IncrementalStructure.h"
+#include "MarketStructure.h"
+#include "OrderBlock.h"
+#include "StructureUtils.h"
+
+// Incremental engine vs batch pipeline over the same bars, shared by the replay
+// benchmark and the ReplayCheck test
+namespace ReplayCheck
+{
+    inline bool samePoints(const std::vector<StructurePoint> &a, const std::vector<StructurePoint> &b)
+    {
+        return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const StructurePoint &x, const StructurePoint &y)
+                          { return x.index == y.index && x.type == y.type && x.price == y.price && x.timestamp == y.timestamp; });
+    }
+
+    inline bool sameZones(const std::vector<std::pair<OBZone, std::string>> &a,
+                          const std::vector<std::pair<OBZone, std::string>> &b)
+    {
+        return std::equal(a.begin(), a.end(), b.begin(), b.end(),
+                          [](const std::pair<OBZone, std::string> &x, const std::pair<OBZone, std::string> &y)
+                          {
+                              return x.first.timestamp == y.first.timestamp && x.first.top == y.first.top &&
+                                     x.first.bottom == y.first.bottom && x.first.type == y.first.type && x.second == y.second;
+                          });
+    }
+
+    // Structure events compared as a multiset (the incremental list is in discovery order)
+    inline std::vector<std::tuple<int64_t, int, double>> eventKeys(const std::vector<StructureEvent> &events)
+    {
+        std::vector<std::tuple<int64_t, int, double>> keys;
+        keys.reserve(events.size());
+        for (const auto &e : events)
+            keys.emplace_back(e.timestamp, static_cast<int>(e.type), e.price);
+        std::sort(keys.begin(), keys.end());
+        return keys;
+    }
+
+    // Batch pipeline as OrderBlockAnalyzer runs it in "full" mode
+    struct BatchResult
+    {
+        std::vector<StructurePoint> swings, bos, choch, trend;
+        std::vector<std::pair<OBZone, std::string>> orderBlocks;
+        std::vector<StructureEvent> events;
+    };
+
+    inline BatchResult runBatch(const CandleSeries &candles, size_t span)
+    {
+        BatchResult r;
+        r.swings = detectSwingPoints(candles);
+        r.bos = detectBOS(candles, r.swings);
+        r.choch = detectCHoCH(candles, r.swings);
+        r.trend = detectBoundedTrendlineBreaks(candles, r.swings, 0.02, span);
+        r.events = StructureUtils::gatherStructureEvents(r.bos, r.choch, r.trend, candles);
+        r.orderBlocks = detectOrderBlocks(candles);
+        return r;
+    }
+
+    // Empty string when the engine matches the batch detectors over the same bars
+    inline const char *compare(const IncrementalStructure &engine, const BatchResult &batch)
+    {
+        if (!samePoints(batch.swings, engine.getSwingPoints()))
+            return "swing points differ";
+        if (!samePoints(batch.bos, IncrementalStructure::sortByIndex(engine.getBOSPoints())))
+            return "BOS points differ";
+        if (!samePoints(batch.choch, IncrementalStructure::sortByIndex(engine.getCHoCHPoints())))
+            return "CHoCH points differ";
+        if (!samePoints(batch.trend, IncrementalStructure::sortByIndex(engine.getTrendlineBreaks())))
+            return "trendline breaks differ";
+        if (!sameZones(batch.orderBlocks, engine.getOrderBlocks()))
+            return "order blocks differ";
+        if (eventKeys(batch.events) != eventKeys(engine.getStructureEvents()))
+            return "structure events differ";
+        return "";
+    }
+
+    // Append `candles` one at a time and compare after each; the first mismatching
+    // bar goes to `failedBar`
+    inline const char *replay(const std::vector<Candle> &candles, size_t span, size_t &failedBar)
+    {
+        IncrementalStructure engine(2, 0.02, 0.02, span);
+        CandleSeries prefix;
+        for (size_t i = 0; i < candles.size(); ++i)
+        {
+            engine.append(candles[i]);
+            prefix.push_back(candles[i]);
+            const char *error = compare(engine, runBatch(prefix, span));
+            if (*error)
+            {
+                failedBar = i;
+                return error;
+            }
+        }
+        return "";
+    }
+
+    // BOS timing, which the backtest, the sweep and the live engine must agree on: the
+    // bar the engine discovers each BOS on must be the knownAt of bosKnownBars, and its
+    // bars must be detectBOS's
+    inline const char *bosTiming(const std::vector<Candle> &candles, int lookback)
+    {
+        IncrementalStructure engine(lookback);
+        std::vector<std::pair<size_t, size_t>> discovered; // (bar, knownAt)
+        for (size_t i = 0; i < candles.size(); ++i)
+        {
+            const size_t before = engine.getBOSPoints().size();
+            engine.append(candles[i]);
+            for (size_t k = before; k < engine.getBOSPoints().size(); ++k)
+                discovered.emplace_back(engine.getBOSPoints()[k].index, i);
+        }
+
+        const CandleSeries series(candles);
+        const std::vector<StructurePoint> swings = detectSwingPoints(series, lookback);
+        std::vector<std::pair<size_t, size_t>> known;
+        std::vector<size_t> knownBars, batchBars;
+        for (const KnownBOS &bos : bosKnownBars(series, swings, lookback))
+        {
+            known.emplace_back(bos.bar, bos.knownAt);
+            knownBars.push_back(bos.bar);
+        }
+        for (const auto &point : detectBOS(series, swings))
+            batchBars.push_back(point.index);
+
+        std::sort(discovered.begin(), discovered.end());
+        std::sort(known.begin(), known.end());
+        std::sort(knownBars.begin(), knownBars.end());
+        if (knownBars != batchBars)
+            return "bosKnownBars bars differ from detectBOS";
+        if (known != discovered)
+            return "BOS known-at bars differ from the incremental engine";
+        return "";
+    }
+}
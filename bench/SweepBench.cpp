@@ -0,0 +1,42 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "BenchData.h"
+#include "ParameterSweep.h"
+
+namespace
+{
+    // 4 lookbacks x 4 retrace x 2 trendline x 2 ATR x 2 risk x 2 reward = 256 backtests
+    std::vector<SweepParams> sweepGrid()
+    {
+        SweepSpace space;
+        space.swingLookbacks = {2, 3, 5, 8};
+        space.retraceThresholds = {0.005, 0.01, 0.02, 0.04};
+        space.trendlineThresholds = {0.01, 0.02};
+        space.atrPeriods = {14, 28};
+        space.riskATRMultipliers = {1.0, 2.0};
+        space.rewardRiskRatios = {1.5, 3.0};
+        return space.grid();
+    }
+}
+
+// Whole sweep, including the per-lookback swing cache (a fresh ParameterSweep each iteration)
+static void BM_Sweep(benchmark::State &state)
+{
+    const size_t bars = static_cast<size_t>(state.range(0));
+    const size_t threads = static_cast<size_t>(state.range(1));
+    const CandleSeries candles = BenchData::randomWalkSeries(bars);
+    const std::vector<SweepParams> configs = sweepGrid();
+
+    for (auto _ : state)
+    {
+        const ParameterSweep sweep(candles);
+        std::vector<SweepResult> results = sweep.run(configs, threads);
+        benchmark::DoNotOptimize(results.data());
+    }
+    // items/s = backtests per second
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(configs.size()));
+}
+BENCHMARK(BM_Sweep)
+    ->ArgsProduct({{10000, 100000}, {1, 4}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
@@ -0,0 +1,64 @@
+#include <benchmark/benchmark.h>
+#include "BenchData.h"
+#include "MarketStructure.h"
+
+// Legacy detector: every same-type pivot pair, every bar between them.
+// Roughly cubic (about 10 s at 4k bars), so it is only run on small series.
+static void BM_TrendlineBreak_AllPairs(benchmark::State &state)
+{
+    const size_t bars = static_cast<size_t>(state.range(0));
+    const CandleSeries candles = BenchData::randomWalkSeries(bars);
+    const auto swings = detectSwingPoints(candles);
+
+    for (auto _ : state)
+    {
+        auto breaks = detectTrendlineBreak(candles, swings);
+        benchmark::DoNotOptimize(breaks.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(bars));
+    state.counters["swings"] = static_cast<double>(swings.size());
+}
+BENCHMARK(BM_TrendlineBreak_AllPairs)->RangeMultiplier(2)->Range(1 << 9, 1 << 12)->Unit(benchmark::kMillisecond);
+
+// Bounded pivot pairs (span = number of previous same-type pivots joined to each new one)
+static void BM_TrendlineBreak_Bounded(benchmark::State &state)
+{
+    const size_t bars = static_cast<size_t>(state.range(0));
+    const size_t span = static_cast<size_t>(state.range(1));
+    const CandleSeries candles = BenchData::randomWalkSeries(bars);
+    const auto swings = detectSwingPoints(candles);
+
+    for (auto _ : state)
+    {
+        auto breaks = detectBoundedTrendlineBreaks(candles, swings, 0.02, span);
+        benchmark::DoNotOptimize(breaks.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(bars));
+    state.counters["swings"] = static_cast<double>(swings.size());
+}
+BENCHMARK(BM_TrendlineBreak_Bounded)
+    ->ArgsProduct({benchmark::CreateRange(1 << 10, 1 << 20, 8), {1, 4}})
+    ->Unit(benchmark::kMillisecond);
+
+// Streaming: swings are fed to the detector as they are confirmed bar by bar
+static void BM_TrendlineBreak_Streaming(benchmark::State &state)
+{
+    const size_t bars = static_cast<size_t>(state.range(0));
+    const CandleSeries candles = BenchData::randomWalkSeries(bars);
+
+    for (auto _ : state)
+    {
+        SwingDetector swings(2);
+        TrendlineBreakDetector trendlines;
+        std::vector<StructurePoint> breaks;
+        StructurePoint swing;
+        for (size_t i = 0; i < bars; ++i)
+        {
+            if (swings.push(candles.high[i], candles.low[i], candles.timestamp[i], swing))
+                trendlines.addSwing(swing, candles, breaks);
+        }
+        benchmark::DoNotOptimize(breaks.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(bars));
+}
+BENCHMARK(BM_TrendlineBreak_Streaming)->RangeMultiplier(8)->Range(1 << 10, 1 << 20)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,108 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <vector>
+#include "BenchData.h"
+#include "OrderBlock.h"
+#include "ZoneBook.h"
+#include "ZoneIndex.h"
+
+// "Which zones did this candle touch": every order block of a random walk is live,
+// and each bar's [low, high] range is tested against all of them.
+// range(0) is the number of bars (order blocks are roughly 1 in 12 bars).
+
+namespace
+{
+    std::vector<OBZone> zonesOf(const CandleSeries &candles)
+    {
+        std::vector<OBZone> zones;
+        for (const auto &ob : detectOrderBlocks(candles))
+            zones.push_back(ob.first);
+        return zones;
+    }
+}
+
+static void BM_ZoneTouch_Linear(benchmark::State &state)
+{
+    const CandleSeries candles = BenchData::randomWalkSeries(static_cast<size_t>(state.range(0)));
+    const std::vector<OBZone> zones = zonesOf(candles);
+    const size_t queries = std::min<size_t>(candles.size(), 10000);
+
+    for (auto _ : state)
+    {
+        size_t touched = 0;
+        for (size_t i = 0; i < queries; ++i)
+        {
+            for (const auto &zone : zones)
+            {
+                if (candles.low[i] <= std::max(zone.bottom, zone.top) && candles.high[i] >= std::min(zone.bottom, zone.top))
+                    ++touched;
+            }
+        }
+        benchmark::DoNotOptimize(touched);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(queries));
+    state.counters["zones"] = static_cast<double>(zones.size());
+}
+BENCHMARK(BM_ZoneTouch_Linear)->RangeMultiplier(10)->Range(10000, 1000000)->Unit(benchmark::kMillisecond);
+
+static void BM_ZoneTouch_Index(benchmark::State &state)
+{
+    const CandleSeries candles = BenchData::randomWalkSeries(static_cast<size_t>(state.range(0)));
+    const std::vector<OBZone> zones = zonesOf(candles);
+    const size_t queries = std::min<size_t>(candles.size(), 10000);
+
+    ZoneIndex index;
+    for (const auto &zone : zones)
+        index.insert(zone);
+
+    for (auto _ : state)
+    {
+        size_t touched = 0;
+        for (size_t i = 0; i < queries; ++i)
+            index.forEachOverlapping(candles.low[i], candles.high[i], [&touched](ZoneIndex::Id) { ++touched; });
+        benchmark::DoNotOptimize(touched);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(queries));
+    state.counters["zones"] = static_cast<double>(zones.size());
+}
+BENCHMARK(BM_ZoneTouch_Index)->RangeMultiplier(10)->Range(10000, 1000000)->Unit(benchmark::kMillisecond);
+
+// Zones created and invalidated as they would be live: insert every zone, then
+// remove them oldest first
+static void BM_ZoneIndex_InsertRemove(benchmark::State &state)
+{
+    const CandleSeries candles = BenchData::randomWalkSeries(static_cast<size_t>(state.range(0)));
+    const std::vector<OBZone> zones = zonesOf(candles);
+    std::vector<ZoneIndex::Id> ids(zones.size());
+
+    for (auto _ : state)
+    {
+        ZoneIndex index;
+        for (size_t k = 0; k < zones.size(); ++k)
+            ids[k] = index.insert(zones[k]);
+        for (ZoneIndex::Id id : ids)
+            index.remove(id);
+        benchmark::DoNotOptimize(index.size());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(zones.size()));
+}
+BENCHMARK(BM_ZoneIndex_InsertRemove)->RangeMultiplier(10)->Range(10000, 1000000)->Unit(benchmark::kMillisecond);
+
+// ZoneBook fed a whole history bar by bar; bars/s should not fall as zones accumulate
+static void BM_ZoneBook_Update(benchmark::State &state)
+{
+    const CandleSeries candles = BenchData::randomWalkSeries(static_cast<size_t>(state.range(0)));
+    size_t live = 0;
+
+    for (auto _ : state)
+    {
+        ZoneBook book;
+        for (size_t i = 0; i < candles.size(); ++i)
+            book.update(candles, i);
+        live = book.size();
+        benchmark::DoNotOptimize(live);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["live"] = static_cast<double>(live);
+}
+BENCHMARK(BM_ZoneBook_Update)->RangeMultiplier(10)->Range(10000, 1000000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,124 @@
+#ifndef ASYNCLOG_H
+#define ASYNCLOG_H
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <spdlog/formatter.h>
+#include <spdlog/sinks/sink.h>
+
+// What a logging thread does when the queue is full
+enum class LogOverflow {
+    Block,   // wait for the writer to free a slot (never for I/O itself)
+    Drop     // discard the message; the writer reports how many were lost
+};
+
+// Bounded lock-free multi-producer queue of log records, drained by one background
+// writer thread that formats them and hands them to their destination sinks.
+// Producers copy the message into a preallocated slot (its strings keep their
+// capacity, so steady-state logging does not allocate) and only touch a mutex to
+// wake the writer when it is asleep.
+class AsyncLogQueue {
+public:
+    // `capacity` is rounded up to a power of two
+    AsyncLogQueue(size_t capacity, LogOverflow overflow);
+    ~AsyncLogQueue();
+
+    AsyncLogQueue(const AsyncLogQueue&) = delete;
+    AsyncLogQueue& operator=(const AsyncLogQueue&) = delete;
+
+    // False when the message was dropped or the queue is stopped
+    bool push(const std::shared_ptr<spdlog::sinks::sink>& sink, const spdlog::details::log_msg& msg);
+    bool pushFlush(const std::shared_ptr<spdlog::sinks::sink>& sink);
+
+    // Writes everything queued so far, then joins the writer. Later pushes fail.
+    void stop();
+
+    bool running() const { return !stopping.load(std::memory_order_acquire); }
+    uint64_t droppedCount() const { return dropped.load(std::memory_order_relaxed); }
+
+private:
+    struct Record {
+        std::shared_ptr<spdlog::sinks::sink> sink;
+        spdlog::log_clock::time_point time;
+        spdlog::level::level_enum level = spdlog::level::info;
+        size_t threadId = 0;
+        std::string name;
+        std::string payload;
+        bool flush = false;
+    };
+
+    struct Cell {
+        std::atomic<size_t> sequence{0};
+        Record record;
+    };
+
+    std::vector<Cell> cells;
+    size_t mask;
+    LogOverflow overflow;
+    alignas(64) std::atomic<size_t> enqueuePos{0};
+    alignas(64) size_t dequeuePos = 0;           // writer thread only
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<bool> stopping{false};
+    std::atomic<int> producers{0};               // threads inside push()
+    std::atomic<bool> writerSleeping{false};
+
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    std::mutex stopMutex;
+    std::thread writer;
+
+    template <typename Fill>
+    bool enqueue(Fill fill);
+    bool drainOne();
+    void wakeWriter();
+    void writerLoop();
+};
+
+// Sink that forwards every message to `target` through an AsyncLogQueue. The
+// calling thread only copies the message; formatting and I/O happen on the writer.
+class AsyncSink : public spdlog::sinks::sink {
+public:
+    AsyncSink(std::shared_ptr<AsyncLogQueue> queue, spdlog::sink_ptr target);
+
+    void log(const spdlog::details::log_msg& msg) override;
+    void flush() override;
+    void set_pattern(const std::string& pattern) override;
+    void set_formatter(std::unique_ptr<spdlog::formatter> formatter) override;
+
+private:
+    std::shared_ptr<AsyncLogQueue> queue;
+    spdlog::sink_ptr target;
+};
+
+// One JSON object per line: {"time":"...","level":"...","logger":"...","msg":"..."}
+class JsonLogFormatter : public spdlog::formatter {
+public:
+    void format(const spdlog::details::log_msg& msg, spdlog::memory_buf_t& dest) override;
+    std::unique_ptr<spdlog::formatter> clone() const override;
+};
+
+// Process-wide asynchronous logging
+namespace AsyncLog {
+    struct Options {
+        size_t capacity = 8192;
+        LogOverflow overflow = LogOverflow::Block;
+        bool json = false;          // JsonLogFormatter instead of text patterns
+    };
+
+    // Start the writer and route the default logger through it
+    void start(const Options& options);
+
+    // Console sink using `pattern` (or JSON lines), asynchronous when start() was
+    // called. Every sink made here writes from the same writer thread.
+    spdlog::sink_ptr consoleSink(const std::string& pattern);
+
+    // Write out everything queued and stop the writer (logging becomes synchronous)
+    void stop();
+}
+
+#endif // ASYNCLOG_H
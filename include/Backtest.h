@@ -0,0 +1,80 @@
+#ifndef BACKTEST_H
+#define BACKTEST_H
+
+#include <cstdint>
+#include <vector>
+#include "CandleSeries.h"
+#include "Order.h"
+
+class Strategy;
+
+struct BacktestConfig {
+    double initialCapital = 10000.0;
+    double positionSize = 1.0;        // units per trade
+    double commissionPerTrade = 0.0;  // round trip, charged at exit
+    // An order is known only once its order block is confirmed: the OB candle plus
+    // this many following candles, and not before its activation timestamp (see
+    // Order). It can fill from the bar after the later of the two.
+    size_t confirmationBars = 2;
+    size_t orderExpiryBars = 0;       // unfilled orders are dropped after this many bars (0 = never)
+    size_t atrPeriod = 14;            // of BacktestResult::atr (0 = not computed)
+};
+
+enum class ExitReason {
+    StopLoss,
+    TakeProfit,
+    EndOfData
+};
+
+struct Trade {
+    Order::Type type;
+    size_t entryIndex;
+    size_t exitIndex;
+    int64_t entryTimestamp;
+    int64_t exitTimestamp;
+    double entryPrice;
+    double exitPrice;
+    double stopLoss;
+    double takeProfit;
+    double pnl;
+    ExitReason reason;
+};
+
+struct BacktestResult {
+    std::vector<Trade> trades;    // in exit order
+    std::vector<double> equity;   // per bar, open positions marked to the close
+    std::vector<double> atr;      // per bar, Indicators::atrSeries: the ATR the analyzer reports
+    double finalEquity = 0.0;
+    double maxDrawdown = 0.0;     // largest peak-to-trough fall of `equity`
+    size_t wins = 0;
+    size_t losses = 0;
+    size_t ordersFilled = 0;
+    size_t ordersExpired = 0;
+    size_t ordersUnfilled = 0;    // still working when the data ended
+    size_t ordersRejected = 0;    // unknown timestamp, or stop/target on the wrong side of entry
+};
+
+// Bar-by-bar fill simulation of limit orders with stop-loss / take-profit exits.
+//
+// Each order rests at its entry price from its activation bar on. A BUY fills when
+// the low reaches the entry (at the open if the bar gaps below it); a SELL mirrors that.
+// Open positions exit at the stop or target. A gap through either level exits at the
+// open. When one bar touches both levels, the stop is assumed to have been hit first.
+//
+// The bar loop works on raw column pointers and preallocated buffers: no allocation,
+// no virtual calls and no per-bar strategy callbacks.
+class Backtest {
+public:
+    explicit Backtest(const BacktestConfig& config = BacktestConfig());
+
+    // Orders are matched to bars by timestamp (candles must be in time order)
+    BacktestResult run(const CandleSeries& candles, const std::vector<Order>& orders) const;
+
+    // Let the strategy generate its orders, then simulate them
+    BacktestResult run(const CandleSeries& candles, Strategy& strategy) const;
+
+private:
+    BacktestConfig config;
+};
+
+#endif // BACKTEST_H
@@ -2,7 +2,9 @@
 #define CANDLE_H
 
 #include <string>
+#include <cstdint>
 #include <cmath>
+#include "Utils.h"
 
 class Candle {
 public:
@@ -11,16 +13,16 @@ public:
     double low;
     double close;
     int volume;
-    std::string date;
+    int64_t timestamp;      // Bar open time, UTC epoch seconds
     double changePercent;
 
     // Default Constructor
     Candle() 
-        : open(0.0), high(0.0), low(0.0), close(0.0), volume(0), date(""), changePercent(0.0) {}
+        : open(0.0), high(0.0), low(0.0), close(0.0), volume(0), timestamp(0), changePercent(0.0) {}
 
     // Constructor with all parameters
-    Candle(double o, double h, double l, double c, int v, const std::string& d, double cp)
-        : open(o), high(h), low(l), close(c), volume(v), date(d), changePercent(cp) {}
+    Candle(double o, double h, double l, double c, int v, int64_t ts, double cp)
+        : open(o), high(h), low(l), close(c), volume(v), timestamp(ts), changePercent(cp) {}
 
     // Determine if the candle is bullish
     bool isBullish() const {
@@ -54,7 +56,7 @@ public:
 
     // Get a string representation of the candle for logging or debugging
     std::string toString() const {
-        return "Date: " + date + ", Open: " + std::to_string(open) +
+        return "Date: " + Utils::formatTimestamp(timestamp) + ", Open: " + std::to_string(open) +
                ", High: " + std::to_string(high) + ", Low: " + std::to_string(low) +
                ", Close: " + std::to_string(close) + ", Volume: " + std::to_string(volume) +
                ", Change %: " + std::to_string(changePercent);
@@ -0,0 +1,70 @@
+#ifndef CANDLESERIES_H
+#define CANDLESERIES_H
+
+#include <vector>
+#include <cstdint>
+#include "Candle.h"
+
+// Column-oriented (structure-of-arrays) candle storage.
+// Each field is its own contiguous array, so a detector that only reads
+// highs and lows streams through exactly those bytes.
+class CandleSeries {
+public:
+    std::vector<double> open;
+    std::vector<double> high;
+    std::vector<double> low;
+    std::vector<double> close;
+    std::vector<int> volume;
+    std::vector<double> changePercent;
+    std::vector<int64_t> timestamp;
+
+    CandleSeries() = default;
+    explicit CandleSeries(const std::vector<Candle>& candles);
+
+    size_t size() const { return close.size(); }
+    bool empty() const { return close.empty(); }
+
+    void reserve(size_t n);
+    void clear();
+    void push_back(const Candle& candle);
+
+    // Drop every bar from index n on
+    void truncate(size_t n);
+
+    // Drop the first n bars
+    void dropFront(size_t n);
+
+    // Materialize a single row (for logging and row-oriented callers)
+    Candle at(size_t i) const;
+    std::vector<Candle> toCandles() const;
+
+    bool isBullish(size_t i) const { return close[i] > open[i]; }
+    bool isBearish(size_t i) const { return open[i] > close[i]; }
+};
+
+// Uniform column access, so each detector is written once (as a template)
+// and runs over either std::vector<Candle> or CandleSeries.
+namespace CandleColumns
+{
+    inline size_t size(const std::vector<Candle> &c) { return c.size(); }
+    inline double open(const std::vector<Candle> &c, size_t i) { return c[i].open; }
+    inline double high(const std::vector<Candle> &c, size_t i) { return c[i].high; }
+    inline double low(const std::vector<Candle> &c, size_t i) { return c[i].low; }
+    inline double close(const std::vector<Candle> &c, size_t i) { return c[i].close; }
+    inline int64_t timestamp(const std::vector<Candle> &c, size_t i) { return c[i].timestamp; }
+
+    inline size_t size(const CandleSeries &s) { return s.size(); }
+    inline double open(const CandleSeries &s, size_t i) { return s.open[i]; }
+    inline double high(const CandleSeries &s, size_t i) { return s.high[i]; }
+    inline double low(const CandleSeries &s, size_t i) { return s.low[i]; }
+    inline double close(const CandleSeries &s, size_t i) { return s.close[i]; }
+    inline int64_t timestamp(const CandleSeries &s, size_t i) { return s.timestamp[i]; }
+
+    template <typename Series>
+    bool isBullish(const Series &s, size_t i) { return close(s, i) > open(s, i); }
+
+    template <typename Series>
+    bool isBearish(const Series &s, size_t i) { return open(s, i) > close(s, i); }
+}
+
+#endif // CANDLESERIES_H
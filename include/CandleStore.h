@@ -0,0 +1,43 @@
+#ifndef CANDLESTORE_H
+#define CANDLESTORE_H
+
+#include <cstdint>
+#include <string>
+#include "CandleSeries.h"
+
+// Binary columnar candle file.
+//
+// Layout (little-endian, every block 8-byte aligned):
+//   header (64 bytes)
+//     char     magic[8]       "TSCANDLE"
+//     uint32_t version        1
+//     uint32_t headerSize     64
+//     uint64_t count          number of bars
+//     char     symbol[24]     NUL-padded
+//     char     timeframe[16]  NUL-padded
+//   int64_t  timestamp[count]
+//   double   open[count], high[count], low[count], close[count], changePercent[count]
+//   int32_t  volume[count]
+//
+// Each column is one contiguous block, so loading is a bulk copy per column
+// straight from the mapping into the matching CandleSeries vector.
+struct CandleStoreInfo {
+    std::string symbol;
+    std::string timeframe;
+    uint64_t count = 0;
+};
+
+namespace CandleStore
+{
+    // Write `candles` to `path` (via a temporary file renamed into place)
+    bool write(const std::string& path, const CandleSeries& candles,
+               const std::string& symbol = "", const std::string& timeframe = "");
+
+    // Load a file written by write(); `info` (optional) receives the header metadata
+    bool read(const std::string& path, CandleSeries& candles, CandleStoreInfo* info = nullptr);
+
+    // Header only
+    bool readInfo(const std::string& path, CandleStoreInfo& info);
+}
+
+#endif // CANDLESTORE_H
@@ -1,5 +1,16 @@
 #pragma once
 #include <string>
+#include <vector>
+
+// Data source of one traded symbol
+struct InstrumentConfig
+{
+    std::string symbol;
+    std::string csv_path;
+    std::string data_source;
+    std::string api_endpoint;
+    std::string api_key;
+};
 
 struct Config
 {
@@ -7,6 +18,22 @@ struct Config
     std::string data_source;
     std::string api_endpoint;
     std::string api_key;
+    std::string csv_reader = "stream"; // optional: "stream", "mmap" or "tail"
+    int trendline_pair_span = 1;       // optional: previous same-type pivots joined to each new swing
+    std::string analysis_mode = "full"; // optional: "full" (recompute each cycle) or "incremental"
+    std::string symbol;                // optional: label used in log output
+    int worker_threads = 0;            // optional: analysis threads (0 = one per core)
+    std::string log_format = "text";   // optional: "text" or "json" (one object per line)
+    std::string log_overflow = "block"; // optional: "block" or "drop" when the log queue is full
+    int log_queue_size = 8192;         // optional: messages the async log queue holds
+    std::string api_cache_dir;         // optional: keep API bars on disk here and fetch only new ones
+
+    // Every symbol to analyze. Filled from the "instruments" list when present,
+    // otherwise holds the single top-level source.
+    std::vector<InstrumentConfig> instruments;
 
     static Config load(const std::string &filename);
+
+    // Settings for a single instrument: its data source over the shared options
+    Config forInstrument(const InstrumentConfig &instrument) const;
 };
@@ -1,25 +1,86 @@
 #ifndef DATAREADER_H
 #define DATAREADER_H
 
+#include <cstdint>
+#include <limits>
+#include <memory>
 #include <string>
 #include <vector>
 #include "Candle.h"
+#include "CandleSeries.h"
+
+class KlineCache;
+class KlineFetcher;
+namespace spdlog { class logger; }
 
 class DataReader {
 public:
     // Constructor now accepts apiKey optionally
-    DataReader(const std::string& filepath, const std::string& dataSource, const std::string& apiEndpoint = "", const std::string& apiKey = "");
+    // csvReader selects the CSV ingestion path: "stream" (default), "mmap" or "tail"
+    // apiCacheDir (API source, optional) keeps fetched bars on disk, see KlineCache.h
+    DataReader(const std::string& filepath, const std::string& dataSource, const std::string& apiEndpoint = "", const std::string& apiKey = "",
+               const std::string& csvReader = "stream", const std::string& apiCacheDir = "");
+    ~DataReader();
+
+    DataReader(DataReader&&) noexcept;
+    DataReader& operator=(DataReader&&) noexcept;
 
     std::vector<Candle> readData();
 
+    // Columnar read; a "BIN" source is loaded straight into the columns without parsing
+    CandleSeries readSeries();
+
+    // Read the configured source once and save it as a binary candle store (see CandleStore.h)
+    bool exportBinary(const std::string& path, const std::string& symbol = "", const std::string& timeframe = "");
+
+    // Incremental read. In "tail" mode only rows appended since the previous call are
+    // parsed; otherwise this is readData(). `replaced` is set when the result is the
+    // whole history (first call, truncation or rotation) rather than new bars to append.
+    std::vector<Candle> readNewData(bool& replaced);
+
+    bool followsTail() const { return dataSource == "CSV" && csvReader == "tail"; }
+    bool fromAPI() const { return dataSource == "API"; }
+
+    // API source: the URL the next read requests (only the bars after the cache when there is one)
+    std::string apiRequestUrl() const;
+
+    // API source: hand over the response to apiRequestUrl() fetched elsewhere (e.g. by a
+    // shared KlineFetcher); the next read uses it instead of calling the endpoint
+    void supplyAPIResponse(std::vector<Candle> candles);
+
+    // Load messages and errors go to `log` (null = default logger); it must outlive the reader
+    void setLogger(spdlog::logger* logger) { log = logger; }
+
 private:
     std::string filepath;
-    std::string dataSource;   // Either "CSV" or "API"
+    std::string dataSource;   // "CSV", "API" or "BIN" (binary candle store at filepath)
     std::string apiEndpoint;  // For API fetching
     std::string apiKey;       // API key stored securely
+    std::string csvReader;    // "stream", "mmap" or "tail"
+    spdlog::logger* log = nullptr;
+
+    // Tail-following state: bytes consumed so far (always at a line boundary), the newest
+    // timestamp returned, and what the file looked like, to notice rewrites and rotation
+    uint64_t tailOffset = 0;
+    int64_t tailLastTimestamp = std::numeric_limits<int64_t>::min();
+    uint64_t tailDevice = 0;
+    uint64_t tailInode = 0;
+    std::string tailHead;     // first bytes of the file
+    std::string tailEnd;      // last bytes consumed
+
+    // API state: a persistent connection to apiEndpoint, the on-disk cache and a supplied response
+    std::unique_ptr<KlineFetcher> fetcher;
+    std::unique_ptr<KlineCache> cache;
+    std::vector<Candle> suppliedCandles;
+    bool hasSupplied = false;
 
     std::vector<Candle> readCSV();
+    std::vector<Candle> readCSVMapped();
+    std::vector<Candle> readCSVTail(bool& replaced);
     std::vector<Candle> readAPI();
+    std::vector<Candle> fetchAPI();   // supplied or fetched response, before merging into the cache
+    CandleSeries readBinary();
+    spdlog::logger* logger() const;
 };
 
 #endif // DATAREADER_H
@@ -0,0 +1,157 @@
+#ifndef DETECTIONPIPELINE_H
+#define DETECTIONPIPELINE_H
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "CandleSeries.h"
+#include "Indicators.h"
+#include "MarketStructure.h"
+#include "OrderBlock.h"
+
+// Everything OrderBlockAnalyzer::analyze needs from one history
+struct PipelineResult {
+    std::vector<StructurePoint> swingPoints;
+    std::vector<StructurePoint> bosPoints;
+    std::vector<StructurePoint> chochPoints;
+    std::vector<StructurePoint> trendBreaks;
+    std::vector<std::pair<OBZone, std::string>> orderBlocks;
+    std::vector<StructureEvent> structureEvents;
+
+    // First close inside the latest order block after it formed
+    bool entryFound = false;
+    double entryPrice = 0.0;
+
+    double atr = 0.0;
+};
+
+// One detector of the fused pipeline. Bars arrive in order, in blocks of
+// consecutive indices, during up to two passes:
+//   scan     pass 1, every bar (causal work: swings, order blocks, ...)
+//   resolve  pass 2, for stages that need pass-1 output over the whole history
+//            (BOS tests every bar against every swing; CHoCH needs the swings
+//            before each bar, which pass 1 confirms only later). beginResolve()
+//            returns whether the stage takes part; resolve() returns false once
+//            it needs no more bars.
+// Stages run in the order they were added and see earlier stages' output for
+// the same block.
+class PipelineStage {
+public:
+    virtual ~PipelineStage() = default;
+
+    virtual void begin(const CandleSeries&, PipelineResult&) {}
+    virtual void scan(const CandleSeries&, size_t, size_t, PipelineResult&) {}
+    virtual bool beginResolve(const CandleSeries&, PipelineResult&) { return false; }
+    virtual bool resolve(const CandleSeries&, size_t, size_t, PipelineResult&) { return false; }
+    virtual void finish(const CandleSeries&, PipelineResult&) {}
+};
+
+// Runs its stages over a history in cache-sized blocks: every stage processes a
+// block while it is still in cache, so the history is streamed from memory at most
+// twice instead of once per detector.
+class DetectionPipeline {
+public:
+    static constexpr size_t kBlockBars = 2048;
+
+    DetectionPipeline& add(std::unique_ptr<PipelineStage> stage);
+
+    PipelineResult run(const CandleSeries& candles);
+
+    // The analyzer's detectors, with the same results as running detectSwingPoints,
+    // detectBOS, detectCHoCH, detectBoundedTrendlineBreaks,
+    // StructureUtils::gatherStructureEvents, detectOrderBlocks, the entry search and
+    // Indicators::atrSeries(...).back() one after another.
+    static DetectionPipeline standard(int swingLookback = 2, double retraceThreshold = 0.02,
+                                      double trendlineThreshold = 0.02, size_t trendlinePairSpan = 1,
+                                      size_t atrPeriod = 14);
+
+private:
+    std::vector<std::unique_ptr<PipelineStage>> stages;
+};
+
+// ==============================
+// Standard stages
+// ==============================
+
+// detectSwingPoints
+class SwingStage : public PipelineStage {
+public:
+    explicit SwingStage(int lookback = 2) : detector(lookback) {}
+    void begin(const CandleSeries& candles, PipelineResult& result) override;
+    void scan(const CandleSeries& candles, size_t first, size_t last, PipelineResult& result) override;
+
+private:
+    SwingDetector detector;
+};
+
+// detectBoundedTrendlineBreaks; consumes swings as SwingStage confirms them
+class TrendlineStage : public PipelineStage {
+public:
+    explicit TrendlineStage(double threshold = 0.02, size_t maxPairSpan = 1) : detector(threshold, maxPairSpan) {}
+    void begin(const CandleSeries& candles, PipelineResult& result) override;
+    void scan(const CandleSeries& candles, size_t first, size_t last, PipelineResult& result) override;
+    void finish(const CandleSeries& candles, PipelineResult& result) override;
+
+private:
+    TrendlineBreakDetector detector;
+    size_t nextSwing = 0;
+};
+
+// detectOrderBlocks (the OB at bar i is confirmed by bars i + 1 and i + 2)
+class OrderBlockStage : public PipelineStage {
+public:
+    void scan(const CandleSeries& candles, size_t first, size_t last, PipelineResult& result) override;
+};
+
+// detectBOS: swings sorted by price, popped by the first close beyond them
+class BOSStage : public PipelineStage {
+public:
+    bool beginResolve(const CandleSeries& candles, PipelineResult& result) override;
+    bool resolve(const CandleSeries& candles, size_t first, size_t last, PipelineResult& result) override;
+
+private:
+    std::vector<double> highs;   // ascending
+    std::vector<double> lows;    // descending
+    size_t nextHigh = 0;
+    size_t nextLow = 0;
+};
+
+// detectCHoCH: the swing structure state machine, fed each swing before the bars after it
+class CHoCHStage : public PipelineStage {
+public:
+    explicit CHoCHStage(double retraceThreshold = 0.02) : detector(retraceThreshold) {}
+    bool beginResolve(const CandleSeries& candles, PipelineResult& result) override;
+    bool resolve(const CandleSeries& candles, size_t first, size_t last, PipelineResult& result) override;
+
+private:
+    CHoCHDetector detector;
+    size_t nextSwing = 0;
+};
+
+// Entry search for the latest order block (OrderBlockAnalyzer::report)
+class EntryStage : public PipelineStage {
+public:
+    bool beginResolve(const CandleSeries& candles, PipelineResult& result) override;
+    bool resolve(const CandleSeries& candles, size_t first, size_t last, PipelineResult& result) override;
+
+private:
+    int64_t formedAt = 0;
+    double zoneLow = 0.0;
+    double zoneHigh = 0.0;
+};
+
+// StructureUtils::gatherStructureEvents, and the ATR of the last bar from an
+// Indicators::ATRTracker fed in pass 1 (the tracker incremental mode keeps)
+class SummaryStage : public PipelineStage {
+public:
+    explicit SummaryStage(size_t atrPeriod = 14) : tracker(atrPeriod) {}
+    void begin(const CandleSeries& candles, PipelineResult& result) override;
+    void scan(const CandleSeries& candles, size_t first, size_t last, PipelineResult& result) override;
+    void finish(const CandleSeries& candles, PipelineResult& result) override;
+
+private:
+    Indicators::ATRTracker tracker;
+};
+
+#endif // DETECTIONPIPELINE_H
@@ -0,0 +1,87 @@
+#ifndef INCREMENTALSTRUCTURE_H
+#define INCREMENTALSTRUCTURE_H
+
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Candle.h"
+#include "CandleSeries.h"
+#include "MarketStructure.h"
+#include "OrderBlock.h"
+
+// Bar-by-bar equivalent of the batch pipeline used by OrderBlockAnalyzer:
+// detectSwingPoints, detectBOS, detectCHoCH, detectBoundedTrendlineBreaks,
+// detectOrderBlocks and StructureUtils::gatherStructureEvents.
+// After every append() the outputs equal the batch detectors run over all bars
+// seen so far, at amortized O(log n) per bar.
+//
+// A new swing can be broken by candles that came before it (the batch detectors
+// test every candle against every swing), so BOS and trendline points may be
+// discovered after the fact. Those lists are kept in discovery order;
+// sortByIndex() restores the batch order.
+//
+// CHoCH runs the CHoCHDetector state machine, which needs every swing before a bar.
+// Bars within swingLookback - 1 of the end may still gain an earlier swing, so their
+// CHoCH points are provisional: they are kept at the end of the CHoCH and event
+// lists and re-evaluated on the next append().
+class IncrementalStructure {
+public:
+    explicit IncrementalStructure(int swingLookback = 2, double retraceThreshold = 0.02,
+                                  double trendlineThreshold = 0.02, size_t trendlinePairSpan = 1);
+
+    // Ingest the next bar (bars must arrive in time order)
+    void append(const Candle& candle);
+    void reset();
+
+    size_t size() const { return candles.size(); }
+    const CandleSeries& getCandles() const { return candles; }
+
+    // Index order, like the batch detectors
+    const std::vector<StructurePoint>& getSwingPoints() const { return swingPoints; }
+    const std::vector<std::pair<OBZone, std::string>>& getOrderBlocks() const { return orderBlocks; }
+
+    // Discovery order
+    const std::vector<StructurePoint>& getBOSPoints() const { return bosPoints; }
+    const std::vector<StructurePoint>& getCHoCHPoints() const { return chochPoints; }
+    const std::vector<StructurePoint>& getTrendlineBreaks() const { return trendBreaks; }
+    const std::vector<StructureEvent>& getStructureEvents() const { return structureEvents; }
+
+    static std::vector<StructurePoint> sortByIndex(std::vector<StructurePoint> points);
+
+private:
+    int swingLookback;
+    double retraceThreshold;
+    double trendlineThreshold;
+    size_t trendlinePairSpan;
+
+    CandleSeries candles;
+    SwingDetector swingDetector;
+    TrendlineBreakDetector trendlineDetector;
+
+    std::vector<StructurePoint> swingPoints;
+    std::vector<StructurePoint> bosPoints;
+    std::vector<StructurePoint> chochPoints;
+    std::vector<StructurePoint> trendBreaks;
+    std::vector<std::pair<OBZone, std::string>> orderBlocks;
+    std::vector<StructureEvent> structureEvents;
+
+    // BOS: running extremes of closes from bar 1 on, and swings no candle has broken yet
+    CloseExtremes closeExtremes;
+    std::priority_queue<double, std::vector<double>, std::greater<double>> activeHighs;
+    std::priority_queue<double> activeLows;
+
+    // CHoCH: `choch` has seen every bar before nextCHoCHBar (all final) and the swings
+    // before it; provisionalCHoCH points for later bars sit at the end of the lists
+    CHoCHDetector choch;
+    size_t nextCHoCHBar = 1;
+    size_t nextCHoCHSwing = 0;
+    size_t provisionalCHoCH = 0;
+
+    void onSwing(const StructurePoint& swing);
+    void addBOS(size_t index, size_t count);
+    void addCHoCH(const StructurePoint& point);
+    void updateCHoCH();
+};
+
+#endif // INCREMENTALSTRUCTURE_H
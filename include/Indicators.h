@@ -0,0 +1,62 @@
+#ifndef INDICATORS_H
+#define INDICATORS_H
+
+#include <cstddef>
+#include <vector>
+#include "CandleSeries.h"
+
+// Bar-aligned indicator series over a CandleSeries, and their live counterparts.
+//
+// ATR follows TradingUtils::calculateATR: bar 0 has no previous close, so its true
+// range is never averaged, and the ATR at bar i is defined from i = period on.
+// Simple is the mean true range over bars i - period + 1 .. i. Its window sum is
+// kept running, so it matches calculateATR over bars 0 .. i up to rounding, and
+// exactly at every period-th bar, where the sum is re-added. Wilder starts from that mean at bar `period` and then smooths:
+// atr[i] = (atr[i - 1] * (period - 1) + tr[i]) / period.
+namespace Indicators {
+
+enum class ATRMethod { Simple, Wilder };
+
+// out[i] = max(high[i] - low[i], |high[i] - prevClose[i]|, |low[i] - prevClose[i]|)
+// for i < count, two or four bars per instruction where SSE2 / AVX is available.
+void trueRange(const double* high, const double* low, const double* prevClose, double* out, size_t count);
+
+// True range of every bar; bar 0 (no previous close) gets high - low
+std::vector<double> trueRange(const CandleSeries& candles);
+
+// ATR at every bar, 0 before bar `period` (and everywhere when period is 0)
+std::vector<double> atrSeries(const CandleSeries& candles, size_t period = 14,
+                              ATRMethod method = ATRMethod::Simple);
+
+// ATR of a live feed at O(1) per bar. After pushing bars 0 .. i, value() equals
+// atrSeries(...)[i] for the same period and method.
+class ATRTracker {
+public:
+    explicit ATRTracker(size_t period = 14, ATRMethod method = ATRMethod::Simple);
+
+    // Next bar; returns the ATR up to and including it
+    double push(double high, double low, double close);
+
+    // Next bar's true range when it is already known (atrSeries feeds the kernel's output)
+    double addTrueRange(double trueRange);
+
+    void reset();
+
+    double value() const { return atr; }
+    bool ready() const { return !window.empty() && ranges >= window.size(); }
+    size_t period() const { return window.size(); }
+
+private:
+    ATRMethod method;
+    std::vector<double> window;  // last `period` true ranges, oldest at `next` once full
+    size_t next = 0;
+    size_t ranges = 0;           // true ranges seen (bars after the first)
+    double sum = 0.0;            // of `window`, re-added from scratch each time it wraps
+    double atr = 0.0;
+    double prevClose = 0.0;
+    bool started = false;
+};
+
+} // namespace Indicators
+
+#endif // INDICATORS_H
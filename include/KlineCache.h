@@ -0,0 +1,54 @@
+#ifndef KLINECACHE_H
+#define KLINECACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Candle.h"
+#include "CandleSeries.h"
+
+// Bars downloaded from a kline endpoint, kept on disk between runs as a candle
+// store (see CandleStore.h) named after the endpoint's symbol and interval.
+// Each cycle only the bars from the last cached open time on are requested: the
+// first of them replaces the cached (possibly still forming) last bar and the
+// rest are appended, so the whole series never has to be downloaded again.
+//
+// The cache holds at most one page of the endpoint (its `limit`, 500 when absent,
+// capped at Binance's 1000), the same window an uncached request returns. When
+// more than a page has gone by since the last cached bar (a restart after
+// downtime), the endpoint is requested as is and its page replaces the cache.
+class KlineCache {
+public:
+    // Loads `dir`/<symbol>_<interval>.bin when it exists
+    KlineCache(const std::string& dir, const std::string& endpoint);
+
+    // The endpoint with startTime set to the last cached open time; the endpoint as is
+    // while empty or once the bars missing since then no longer fit in one page
+    std::string requestUrl() const;
+
+    // Bars from the first fetched open time on replace the cached ones; a response that
+    // does not reach back to the cache replaces it. The oldest bars beyond one page are
+    // dropped, then the file is rewritten. An empty response (e.g. a failed fetch)
+    // leaves the cache as it is.
+    void merge(const std::vector<Candle>& fetched);
+
+    const CandleSeries& series() const { return cached; }
+    const std::string& path() const { return file; }
+    size_t pageSize() const { return page; }
+
+    // False for endpoints that pin their own startTime/endTime (they cannot be extended)
+    static bool supports(const std::string& endpoint);
+
+private:
+    std::string endpoint;
+    std::string symbol;
+    std::string interval;
+    std::string file;
+    size_t page;              // bars per response, and the most the cache keeps
+    int64_t intervalSeconds;  // 0 when the interval is not one Binance defines
+    bool behind = false;      // the last startTime response was a full page
+    CandleSeries cached;
+};
+
+#endif // KLINECACHE_H
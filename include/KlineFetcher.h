@@ -0,0 +1,54 @@
+#ifndef KLINEFETCHER_H
+#define KLINEFETCHER_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Candle.h"
+
+// Fetches kline endpoints over one libcurl multi handle. Every source keeps its
+// easy handle between cycles, so connections (and DNS/TLS state) are reused, and
+// fetchAll() runs all requests concurrently, multiplexed over HTTP/2 where the
+// server supports it. Each response is parsed and handed to the callback as soon
+// as it completes, in completion order.
+//
+// Not thread-safe: one thread drives a fetcher at a time.
+class KlineFetcher {
+public:
+    // Called once per source: `ok` is false (and candles empty) when the transfer,
+    // the HTTP status or the body failed; the error has been printed
+    using Callback = std::function<void(size_t source, std::vector<Candle>&& candles, bool ok)>;
+
+    explicit KlineFetcher(long timeoutMs = 30000);
+    ~KlineFetcher();
+
+    KlineFetcher(const KlineFetcher&) = delete;
+    KlineFetcher& operator=(const KlineFetcher&) = delete;
+
+    // Register an endpoint; returns its source id (0, 1, 2, ...)
+    size_t add(const std::string& url);
+
+    // Point an existing source at another URL (keeps its connection when the host matches)
+    void setUrl(size_t source, const std::string& url);
+
+    size_t size() const { return sources.size(); }
+    const std::string& url(size_t source) const;
+
+    // Fetch every source concurrently; returns once all have completed or failed
+    void fetchAll(const Callback& onDone);
+
+    // Fetch one source (reusing its connection); false on failure
+    bool fetch(size_t source, std::vector<Candle>& out);
+
+private:
+    struct Source;
+
+    long timeoutMs;
+    void* multi;                                   // CURLM*
+    std::vector<std::unique_ptr<Source>> sources;
+
+    void run(const std::vector<size_t>& ids, const Callback& onDone);
+};
+
+#endif // KLINEFETCHER_H
@@ -0,0 +1,15 @@
+#ifndef KLINEPARSER_H
+#define KLINEPARSER_H
+
+#include <string>
+#include <vector>
+#include "Candle.h"
+
+namespace KlineParser {
+    // Binance kline array ([[openTimeMs, "open", "high", "low", "close", "volume", ...], ...])
+    // to candles in time order, parsed in one pass into `out` (its capacity is reused).
+    // Prints the error and returns false, with `out` empty, on malformed input.
+    bool parse(const std::string& body, std::vector<Candle>& out);
+}
+
+#endif // KLINEPARSER_H
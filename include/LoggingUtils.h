@@ -1,12 +1,15 @@
 #pragma once
 #include "OrderBlock.h"
-#include "Candle.h"
+#include "CandleSeries.h"
 #include <vector>
 #include <string>
+#include <cstdint>
+
+namespace spdlog { class logger; }
 
 namespace LoggingUtils
 {
     void logOrderBlockInfo(const OrderBlock &obBlock, const OBZone &obZone, const std::string &obType,
-                           const std::string &latestDate, bool foundEntry, double entryPrice,
-                           const std::vector<Candle> &candles);
+                           int64_t detectedAt, bool foundEntry, double entryPrice,
+                           const CandleSeries &candles, spdlog::logger *log = nullptr); // null = default logger
 }
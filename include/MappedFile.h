@@ -0,0 +1,34 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+
+// Read-only memory mapping of a whole file.
+// The mapping is released when the object goes out of scope.
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    // True when the file was opened (an empty file is open with size() == 0)
+    bool isOpen() const { return opened; }
+
+    const char* data() const { return ptr; }
+    size_t size() const { return length; }
+
+private:
+    const char* ptr = nullptr;
+    size_t length = 0;
+    bool opened = false;
+
+    void release();
+};
+
+#endif // MAPPEDFILE_H
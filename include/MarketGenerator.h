@@ -0,0 +1,91 @@
+#ifndef MARKETGENERATOR_H
+#define MARKETGENERATOR_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Candle.h"
+#include "CandleSeries.h"
+
+enum class MarketModel {
+    RandomWalk,        // arithmetic steps, reflected off a floor at 1% of the start price
+    GBM,               // geometric Brownian motion
+    RegimeSwitching,   // Markov switching between a calm and a stressed regime
+    TrendWithPullbacks // alternating trend legs and shorter counter-trend pullbacks
+};
+
+struct GeneratorConfig {
+    MarketModel model = MarketModel::GBM;
+    uint64_t seed = 42;
+    double startPrice = 1.25;
+    int64_t startTime = 1577836800;   // 2020-01-01 00:00:00 UTC
+    int64_t barSeconds = 3600;        // bar frequency
+    double volatility = 0.002;        // per-bar standard deviation of the return
+    double drift = 0.0;               // per-bar mean log return (GBM, RegimeSwitching calm regime)
+    double wickScale = 0.5;           // mean wick length in units of volatility * price
+    int baseVolume = 1000;            // volume is uniform in [0.5, 1.5) * baseVolume
+
+    // RegimeSwitching
+    double regimeSwitchProbability = 0.005;  // per bar
+    double stressedVolatility = 3.0;         // multiple of `volatility`
+    double stressedDrift = 0.0;              // per-bar mean log return while stressed
+
+    // TrendWithPullbacks
+    double trendLength = 120;         // mean trend leg length in bars
+    double pullbackLength = 30;       // mean pullback length in bars
+    double trendDrift = 0.0005;       // per-bar log drift during a trend leg
+    double pullbackDrift = 0.001;     // per-bar log drift against the trend during a pullback
+    double reversalProbability = 0.3; // chance the trend flips after each pullback
+};
+
+// Deterministic OHLCV generator. Every bar opens at the previous close; the wicks
+// extend past the body by exponentially distributed amounts.
+//
+// Random draws come from xoshiro256** through our own transforms (not the <random>
+// distributions, whose output differs between standard libraries), so a given
+// config and seed produce the same bars on every platform.
+class MarketGenerator {
+public:
+    explicit MarketGenerator(const GeneratorConfig& config = GeneratorConfig());
+
+    Candle next();
+
+    // Append the next `bars` bars straight into the columns of `out`
+    void append(size_t bars, CandleSeries& out);
+
+    // Back to the first bar
+    void reset();
+
+    // "random_walk", "gbm", "regime" or "trend"
+    static bool parseModel(const std::string& name, MarketModel& model);
+
+private:
+    GeneratorConfig config;
+    uint64_t rngState[4];
+    double price;
+    int64_t timestamp;
+    double spareNormal;
+    bool hasSpareNormal;
+
+    // RegimeSwitching: stressed regime active. TrendWithPullbacks: current leg.
+    bool stressed;
+    bool inPullback;
+    int trendDirection;
+
+    double uniform();       // (0, 1)
+    double normal();
+    double exponential();   // mean 1
+    double nextClose();
+};
+
+std::vector<Candle> generateCandles(const GeneratorConfig& config, size_t bars);
+CandleSeries generateSeries(const GeneratorConfig& config, size_t bars);
+
+// Write `bars` generated bars to `path` in the layout of the files in data/ (a title
+// line, a header, then one CRLF row per bar, newest first, dated MM/DD/YYYY HH:MM),
+// with a Volume column before Change(Pips) and Change(%). Prices are written with
+// 5 decimals. Bars are generated in chunks, so memory use does not grow with `bars`.
+bool writeGeneratedCSV(const std::string& path, const GeneratorConfig& config, size_t bars,
+                       const std::string& symbol = "SYNTHETIC");
+
+#endif // MARKETGENERATOR_H
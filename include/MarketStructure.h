@@ -1,9 +1,11 @@
 #ifndef MARKETSTRUCTURE_H
 #define MARKETSTRUCTURE_H
 
+#include <deque>
 #include <vector>
-#include <string>
+#include <cstdint>
 #include "Candle.h"
+#include "CandleSeries.h"
 
 enum class StructureType {
     SwingHigh,
@@ -15,16 +17,184 @@ enum class StructureType {
 };
 
 struct StructurePoint {
-    std::string date;
+    int64_t timestamp;      // UTC epoch seconds of the candle at `index`
     double price;
     StructureType type;
     size_t index;
 };
 
+// Streaming swing-point detector with the same rules as detectSwingPoints
+// (strictly above/below every bar within `lookback` on both sides; a swing high
+// takes precedence over a swing low on the same bar).
+// Sliding-window maxima/minima are kept in monotonic queues, so each bar costs
+// O(1) amortized whatever the lookback. A bar is classified once `lookback`
+// further bars have been pushed.
+class SwingDetector {
+public:
+    explicit SwingDetector(int lookback = 2);
+
+    // Feed the next bar. Returns true and fills `out` when the bar pushed
+    // `lookback` bars earlier turns out to be a swing point.
+    bool push(double high, double low, int64_t timestamp, StructurePoint& out);
+
+    void reset();
+
+    int getLookback() const { return lookback; }
+    size_t barCount() const { return count; }
+
+private:
+    struct Slot {
+        size_t index;
+        double value;
+    };
+
+    // Fixed-capacity double-ended queue over a power-of-two ring buffer
+    struct MonotonicQueue {
+        std::vector<Slot> ring;
+        size_t head = 0;
+        size_t length = 0;
+
+        void clear() { head = 0; length = 0; }
+        void evictBefore(size_t index);
+        template <typename Dominates> void push(size_t index, double value, Dominates dominates);
+        double front() const { return ring[head].value; }
+    };
+
+    int lookback;
+    size_t count = 0;
+    MonotonicQueue maxQueue;
+    MonotonicQueue minQueue;
+
+    // Rings over (at least) the most recent lookback + 2 bars
+    std::vector<double> highs;
+    std::vector<double> lows;
+    std::vector<int64_t> timestamps;
+    std::vector<double> windowMax;   // max(high) of the `lookback` bars ending at each bar
+    std::vector<double> windowMin;   // min(low) of the `lookback` bars ending at each bar
+};
+
+// Incremental trendline-break detector.
+// Each new swing is joined to the previous `maxPairSpan` swings of the same type
+// (1 = adjacent pivots only) and every close strictly between the two pivots is
+// tested against that line with the rule used by detectTrendlineBreak. A candle is
+// reported at most once, however many lines it breaks.
+class TrendlineBreakDetector {
+public:
+    explicit TrendlineBreakDetector(double threshold = 0.02, size_t maxPairSpan = 1);
+
+    // Register the next confirmed swing point (swings must arrive in index order);
+    // `candles` must cover every bar up to swing.index. Newly broken candles are
+    // appended to `out` in ascending index order; returns how many were appended.
+    size_t addSwing(const StructurePoint& swing, const std::vector<Candle>& candles, std::vector<StructurePoint>& out);
+    size_t addSwing(const StructurePoint& swing, const CandleSeries& candles, std::vector<StructurePoint>& out);
+
+    void reset();
+
+private:
+    double threshold;
+    size_t maxPairSpan;
+    std::vector<StructurePoint> recentHighs;  // last maxPairSpan swing highs, oldest first
+    std::vector<StructurePoint> recentLows;   // last maxPairSpan swing lows, oldest first
+    // Per-bar flag "break already emitted", from bar reportedBase on: bars up to the oldest
+    // pivot can never be tested again, so the window moves on as pivots are evicted
+    std::deque<char> reported;
+    size_t reportedBase = 0;
+    std::vector<size_t> scratch;
+
+    template <typename Series>
+    size_t addSwingImpl(const StructurePoint& swing, const Series& candles, std::vector<StructurePoint>& out);
+};
+
+// Change-of-character state machine, O(1) per bar and per swing.
+// Each swing high is compared with the previous one (higher or lower high), each
+// swing low with the previous low. The first HH + HL (as the latest high and low)
+// makes the structure bullish, the first LH + LL bearish. From then on:
+//   bullish: a close below latestSwingLow * (1 - t) is a CHoCH; structure turns bearish
+//   bearish: a close above latestSwingHigh * (1 + t) is a CHoCH; structure turns bullish
+// so each change is flagged once, on the bar that breaks the protected swing, and
+// only swings before a bar count for it.
+class CHoCHDetector {
+public:
+    enum class Trend { None, Bullish, Bearish };
+
+    explicit CHoCHDetector(double retraceThreshold = 0.02);
+
+    // Register the next swing point (index order). It applies to bars pushed after it,
+    // so add every swing with index < i before pushing bar i.
+    void addSwing(const StructurePoint& swing);
+
+    // Feed bar `index`; returns true and fills `out` when its close is a change of character
+    bool push(size_t index, double close, int64_t timestamp, StructurePoint& out);
+
+    void reset();
+
+    Trend trend() const { return state; }
+
+private:
+    double retraceThreshold;
+    Trend state = Trend::None;
+    double lastHigh;           // latest swing high / low (NaN until the first)
+    double lastLow;
+    int highTrend = 0;         // latest high vs the one before: +1 higher, -1 lower or equal, 0 unknown
+    int lowTrend = 0;
+};
+
+// Running extremes of the closes from bar 1 on (detectBOS ignores bar 0's close),
+// for finding the first bar that breaks a swing in O(log n)
+class CloseExtremes {
+public:
+    // Feed the next bar's close
+    void push(double close);
+    void clear();
+
+    size_t size() const { return maxClose.size(); }
+
+    // First bar whose close is beyond the swing (above a high, below a low);
+    // size() when no bar so far breaks it or the swing can never be broken
+    size_t firstBreak(const StructurePoint& swing) const;
+
+private:
+    std::vector<double> maxClose;
+    std::vector<double> minClose;
+};
+
+// A BOS of detectBOS and the bar from which a live feed can see it: its swing is
+// detected `lookback` bars after its index, possibly after the breaking close
+struct KnownBOS {
+    size_t bar;      // the breaking close, detectBOS's point
+    size_t knownAt;  // max(bar, swing index + lookback)
+};
+
 std::vector<StructurePoint> detectSwingPoints(const std::vector<Candle>& candles, int lookback = 2);
 std::vector<StructurePoint> detectBOS(const std::vector<Candle>& candles, const std::vector<StructurePoint>& swingPoints);
+// CHoCHDetector over the whole series; each swing applies from the bar after its index
 std::vector<StructurePoint> detectCHoCH(const std::vector<Candle>& candles, const std::vector<StructurePoint>& swingPoints, double retraceThreshold = 0.02);
 std::vector<StructurePoint> detectTrendlineBreak(const std::vector<Candle>& candles, const std::vector<StructurePoint>& swingPoints, double threshold = 0.02);
+
+// Trendline breaks over bounded pivot pairs (see TrendlineBreakDetector):
+// at most one break per candle, sorted by candle index
+std::vector<StructurePoint> detectBoundedTrendlineBreaks(const std::vector<Candle>& candles, const std::vector<StructurePoint>& swingPoints,
+                                                         double threshold = 0.02, size_t maxPairSpan = 1);
 std::vector<StructurePoint> detectStructure(const std::vector<Candle>& candles, StructureType type, double retraceThreshold = 0.02);
 
+// Swing points for several lookbacks in a single pass over the candles;
+// result[k] equals detectSwingPoints(candles, lookbacks[k])
+std::vector<std::vector<StructurePoint>> detectSwingPointsMulti(const std::vector<Candle>& candles, const std::vector<int>& lookbacks);
+
+// One KnownBOS per broken swing index, in the order of `swingPoints` (index order, as
+// detectSwingPoints returns them): the backtest, the sweep and IncrementalStructure
+// all date BOS events this way
+std::vector<KnownBOS> bosKnownBars(const std::vector<Candle>& candles, const std::vector<StructurePoint>& swingPoints, int lookback);
+
+// Columnar overloads (same results as the std::vector<Candle> versions)
+std::vector<StructurePoint> detectSwingPoints(const CandleSeries& candles, int lookback = 2);
+std::vector<StructurePoint> detectBOS(const CandleSeries& candles, const std::vector<StructurePoint>& swingPoints);
+std::vector<StructurePoint> detectCHoCH(const CandleSeries& candles, const std::vector<StructurePoint>& swingPoints, double retraceThreshold = 0.02);
+std::vector<StructurePoint> detectTrendlineBreak(const CandleSeries& candles, const std::vector<StructurePoint>& swingPoints, double threshold = 0.02);
+std::vector<StructurePoint> detectBoundedTrendlineBreaks(const CandleSeries& candles, const std::vector<StructurePoint>& swingPoints,
+                                                         double threshold = 0.02, size_t maxPairSpan = 1);
+std::vector<StructurePoint> detectStructure(const CandleSeries& candles, StructureType type, double retraceThreshold = 0.02);
+std::vector<std::vector<StructurePoint>> detectSwingPointsMulti(const CandleSeries& candles, const std::vector<int>& lookbacks);
+std::vector<KnownBOS> bosKnownBars(const CandleSeries& candles, const std::vector<StructurePoint>& swingPoints, int lookback);
+
 #endif // MARKETSTRUCTURE_H
@@ -0,0 +1,32 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include "Config.h"
+#include "KlineFetcher.h"
+#include "OrderBlockAnalyzer.h"
+#include "ThreadPool.h"
+
+// Runs one OrderBlockAnalyzer per configured instrument on a fixed worker pool.
+// Each analyzer owns its reader, detector state and logger, and runCycle() waits for
+// every symbol before returning, so an analyzer is never used by two threads at once.
+// API instruments are fetched together over one KlineFetcher, and each symbol is
+// analyzed as soon as its own response has arrived.
+class MultiSymbolRunner
+{
+    std::vector<std::unique_ptr<OrderBlockAnalyzer>> analyzers;
+    std::vector<std::string> symbols;
+    ThreadPool pool;
+    KlineFetcher fetcher;
+    std::vector<size_t> fetchedAnalyzer; // fetcher source id -> analyzer index
+
+    void submit(size_t i);
+
+public:
+    explicit MultiSymbolRunner(const Config &config);
+
+    // Analyze every symbol once
+    void runCycle();
+
+    size_t symbolCount() const { return analyzers.size(); }
+    size_t threadCount() const { return pool.size(); }
+};
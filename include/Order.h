@@ -1,7 +1,7 @@
 #ifndef ORDER_H
 #define ORDER_H
 
-#include <string>
+#include <cstdint>
 
 class Order {
 public:
@@ -17,12 +17,17 @@ public:
     };
 
     // Constructor to initialize an order
-    Order(Type type, double price, const std::string& date, double stopLoss, double takeProfit);
+    Order(Type type, double price, int64_t timestamp, double stopLoss, double takeProfit);
+
+    // `activationTimestamp` is the bar whose close makes the signal known (e.g. the
+    // bar a confirming CHoCH/BOS can first be detected); it defaults to `timestamp`
+    Order(Type type, double price, int64_t timestamp, double stopLoss, double takeProfit, int64_t activationTimestamp);
 
     // Getters
     Type getType() const;
     double getEntryPrice() const;
-    const std::string& getOrderDate() const;
+    int64_t getOrderTimestamp() const;
+    int64_t getActivationTimestamp() const;
     double getStopLoss() const;
     double getTakeProfit() const;
     Status getStatus() const;
@@ -34,7 +39,8 @@ public:
 private:
     Type orderType;   // Type of order (BUY or SELL)
     double entryPrice; // Entry price at which the order is placed
-    std::string orderDate; // The date of the order
+    int64_t orderTimestamp; // Time of the order (UTC epoch seconds)
+    int64_t activationTimestamp; // Time the order's signal is known (UTC epoch seconds)
     double stopLoss;  // Stop loss for the order
     double takeProfit; // Take profit for the order
     Status status;    // Status of the order (PENDING, EXECUTED, CANCELLED)
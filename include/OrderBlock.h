@@ -3,8 +3,11 @@
 
 #include <vector>
 #include <string>
+#include <cstdint>
 #include <algorithm>
+#include <map>
 #include "Candle.h"
+#include "CandleSeries.h"
 #include "MarketStructure.h"
 
 // ========================
@@ -44,7 +47,7 @@ enum class StructureEventType {
 struct OBZone {
     double top;                    // OB upper boundary
     double bottom;                 // OB lower boundary
-    std::string date;             // Detection date
+    int64_t timestamp;            // Detection time (UTC epoch seconds)
     OBType type;                  // Bullish or Bearish
     double score = 0.0;           // Scoring (confluence, reaction, structure)
 };
@@ -53,18 +56,18 @@ struct ConfirmedOB {
     OBZone zone;
     std::string direction;              // Market direction: "Bullish" / "Bearish"
     ConfirmationType confirmation;      // CHoCH / BOS confirmation
-    std::string confirmationDate;
+    int64_t confirmationTimestamp;
 };
 
 struct StructureEvent {
     StructureEventType type;
-    std::string date;
+    int64_t timestamp;
     double price;
 
     StructureEvent(StructureEventType t = StructureEventType::None,
-                   const std::string& d = "",
+                   int64_t ts = 0,
                    double p = 0.0)
-        : type(t), date(d), price(p) {}
+        : type(t), timestamp(ts), price(p) {}
 };
 
 // ========================
@@ -73,7 +76,7 @@ struct StructureEvent {
 
 class OrderBlock {
 public:
-    std::string date;
+    int64_t timestamp;
     double top;
     double bottom;
     double entryPrice;
@@ -81,12 +84,12 @@ public:
     OBStrength strength;
     double score;
 
-    OrderBlock(const std::string& d, double t, double b, double e, OBType obType, double s = 0.0)
-        : date(d), top(t), bottom(b), entryPrice(e), type(obType), strength(OBStrength::Valid), score(s) {}
+    OrderBlock(int64_t ts, double t, double b, double e, OBType obType, double s = 0.0)
+        : timestamp(ts), top(t), bottom(b), entryPrice(e), type(obType), strength(OBStrength::Valid), score(s) {}
 
     // Construct from OBZone directly
     OrderBlock(const OBZone& zone, double entry)
-        : date(zone.date), top(zone.top), bottom(zone.bottom),
+        : timestamp(zone.timestamp), top(zone.top), bottom(zone.bottom),
           entryPrice(entry), type(zone.type), strength(OBStrength::Valid), score(zone.score) {}
 
     // Update OB strength using structure events
@@ -111,6 +114,10 @@ std::vector<OBZone> findBearishOrderBlocks(const std::vector<Candle>& candles);
 
 std::vector<std::pair<OBZone, std::string>> detectOrderBlocks(const std::vector<Candle>& candles);
 
+// An order block is confirmed by the first CHoCH or BOS after its candle that
+// closes beyond it (above a bullish zone's top, below a bearish zone's bottom);
+// a CHoCH wins over a BOS on the same bar. Results keep the order of rawOBs.
+// O((OBs + structure points) log) via OrderBlockConfirmer.
 std::vector<ConfirmedOB> filterOrderBlocksWithStructure(
     const std::vector<Candle>& candles,
     const std::vector<std::pair<OBZone, std::string>>& rawOBs,
@@ -118,4 +125,53 @@ std::vector<ConfirmedOB> filterOrderBlocksWithStructure(
     const std::vector<StructurePoint>& bos
 );
 
+// Columnar overloads (same results as the std::vector<Candle> versions)
+std::vector<OBZone> findBullishOrderBlocks(const CandleSeries& candles);
+std::vector<OBZone> findBearishOrderBlocks(const CandleSeries& candles);
+
+std::vector<std::pair<OBZone, std::string>> detectOrderBlocks(const CandleSeries& candles);
+
+// Order blocks formed at candle i (requires i + 2 < candles.size()), appended to `out`
+void detectOrderBlocksAt(const CandleSeries& candles, size_t i, std::vector<std::pair<OBZone, std::string>>& out);
+
+std::vector<ConfirmedOB> filterOrderBlocksWithStructure(
+    const CandleSeries& candles,
+    const std::vector<std::pair<OBZone, std::string>>& rawOBs,
+    const std::vector<StructurePoint>& choch,
+    const std::vector<StructurePoint>& bos
+);
+
+// Streaming form of filterOrderBlocksWithStructure. Unconfirmed zones wait in two
+// maps ordered by the edge a structure point has to clear, so a point only visits
+// the zones it confirms.
+//
+// Structure points must arrive in time order (a bar's CHoCH before its BOS). A
+// zone is only confirmed by points after its candle, so add it before the points
+// that follow it; points older than a pending zone skip that zone.
+class OrderBlockConfirmer {
+public:
+    // Returns a ticket (0, 1, 2, ... since the last reset) identifying the zone
+    size_t addOrderBlock(const OBZone& zone, const std::string& direction);
+
+    // Appends the zones `point` confirms to `out` (and their tickets to `tickets`).
+    // Points that are not CHoCH or BOS, or sit at index 0, are ignored.
+    void addStructurePoint(const StructurePoint& point, std::vector<ConfirmedOB>& out,
+                           std::vector<size_t>* tickets = nullptr);
+
+    size_t pendingCount() const { return bullish.size() + bearish.size(); }
+    void reset();
+
+private:
+    struct Pending {
+        OBZone zone;
+        std::string direction;
+        size_t ticket;
+    };
+
+    std::multimap<double, Pending> bullish;   // by top
+    std::multimap<double, Pending> bearish;   // by bottom
+    size_t nextTicket = 0;
+    std::vector<Pending> deferred;
+};
+
 #endif // ORDERBLOCK_H
@@ -1,26 +1,75 @@
 #pragma once
-#include <string>
+#include <cstdint>
+#include <limits>
+#include <memory>
 #include <vector>
 #include "Config.h"
 #include "DataReader.h"
+#include "CandleSeries.h"
 #include "MarketStructure.h"
+#include "IncrementalStructure.h"
+#include "Indicators.h"
+#include "DetectionPipeline.h"
+#include "ZoneBook.h"
+
+namespace spdlog { class logger; }
 
 class OrderBlockAnalyzer
 {
     DataReader reader;
-    std::string lastOrderBlockDate;
-    std::string lastBOSDate;
-    std::string lastCHoCHDate;
-    std::string lastTrendBreakDate;
+    std::shared_ptr<spdlog::logger> log; // per-instrument logger (default logger when not given)
+    size_t trendlinePairSpan;
+    bool incremental;                  // analysis_mode == "incremental"
+    IncrementalStructure structure;    // detector state kept between cycles in incremental mode
+    Indicators::ATRTracker liveATR;    // ATR(14) of the bars in `structure`, one push per new bar
+    CandleSeries history;              // bars analyzed in full mode
+    DetectionPipeline pipeline;        // fused detectors for full mode
+    ZoneBook zoneBook;                 // every live order block, updated bar by bar in both modes
+    double zoneBookLastClose = 0.0;    // last bar fed to zoneBook, to notice a rewritten history
+    int64_t zoneBookLastTime = 0;
+    static constexpr int64_t kNoTimestamp = std::numeric_limits<int64_t>::min();
+
+    int64_t lastOrderBlockTime = kNoTimestamp;
+    int64_t lastBOSTime = kNoTimestamp;
+    int64_t lastCHoCHTime = kNoTimestamp;
+    int64_t lastTrendBreakTime = kNoTimestamp;
 
     std::vector<StructurePoint> recentSwingPoints;
 
 public:
-    explicit OrderBlockAnalyzer(const Config &config);
+    explicit OrderBlockAnalyzer(const Config &config, std::shared_ptr<spdlog::logger> logger = nullptr);
 
     // Runs full analysis, including detecting swings and order blocks
     void analyze();
 
     // Returns the latest detected swing points for external use (read-only)
-    const std::vector<StructurePoint>& getSwingPoints() const { return recentSwingPoints; }
+    const std::vector<StructurePoint>& getSwingPoints() const;
+
+    // Live order blocks of all ages (read-only)
+    const ZoneBook& getZoneBook() const { return zoneBook; }
+
+    // API instruments: candles already fetched for the next analyze() (see MultiSymbolRunner)
+    bool fetchesFromAPI() const { return reader.fromAPI(); }
+    std::string apiRequestUrl() const { return reader.apiRequestUrl(); }
+    void supplyAPIResponse(std::vector<Candle> candles) { reader.supplyAPIResponse(std::move(candles)); }
+
+private:
+    // Refresh `history` (only new rows are read when the reader follows the file tail)
+    const CandleSeries &loadHistory();
+
+    // Feed bars that arrived since the last cycle into `structure` and `liveATR`
+    void ingestNewBars();
+    void appendBar(const Candle &candle);
+    void resetIncrementalState();
+
+    // Feed bars not yet seen by `zoneBook` and log what changed
+    void updateZoneBook(const CandleSeries &candles);
+
+    // Log the latest candle and the newest order block (shared by both modes).
+    // `fused` supplies the entry search and ATR already computed by the pipeline;
+    // without it the ATR comes from liveATR.
+    void report(const CandleSeries &candles,
+                const std::vector<std::pair<OBZone, std::string>> &orderBlocks,
+                const std::vector<StructureEvent> &structureEvents,
+                const PipelineResult *fused = nullptr);
 };
@@ -0,0 +1,97 @@
+#ifndef PARAMETERSWEEP_H
+#define PARAMETERSWEEP_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Backtest.h"
+#include "CandleSeries.h"
+#include "MarketStructure.h"
+#include "OrderBlock.h"
+
+// One point of the parameter space
+struct SweepParams {
+    int swingLookback = 2;            // detectSwingPoints
+    double retraceThreshold = 0.02;   // detectCHoCH
+    double trendlineThreshold = 0.02; // trendline breaks
+    size_t trendlinePairSpan = 1;     // pivots joined per swing (Config::trendline_pair_span)
+    size_t atrPeriod = 14;            // Indicators::atrSeries
+    double riskATRMultiplier = 1.5;   // stop distance in ATRs (logRiskManagement)
+    double rewardRiskRatio = 2.0;     // target distance in stop distances
+};
+
+// Candidate values per parameter
+struct SweepSpace {
+    std::vector<int> swingLookbacks{2};
+    std::vector<double> retraceThresholds{0.02};
+    std::vector<double> trendlineThresholds{0.02};
+    std::vector<size_t> trendlinePairSpans{1};
+    std::vector<size_t> atrPeriods{14};
+    std::vector<double> riskATRMultipliers{1.5};
+    std::vector<double> rewardRiskRatios{2.0};
+
+    // Full cartesian product
+    std::vector<SweepParams> grid() const;
+
+    // `count` random combinations (each parameter drawn independently from its values)
+    std::vector<SweepParams> sample(size_t count, uint64_t seed = 1) const;
+};
+
+struct SweepResult {
+    SweepParams params;
+    size_t trades = 0;
+    size_t wins = 0;
+    double netProfit = 0.0;
+    double maxDrawdown = 0.0;
+    double profitFactor = 0.0;   // gross profit / gross loss (infinite without losses)
+};
+
+// Runs one backtest per parameter set over a shared, read-only candle series.
+//
+// Signals: every order block (detectOrderBlocks) is traded once a structure event
+// (BOS, CHoCH or trendline break) closes beyond the zone in its direction after the OB
+// is confirmed. The batch detectors see the whole series, so each event is given the
+// bar at which it becomes known: the later of its own bar and the confirmation of the
+// swing(s) it depends on (swing index + lookback). The order is placed on that bar.
+// It is a limit at the zone edge, with the stop riskATRMultiplier * ATR(atrPeriod)
+// away and the target rewardRiskRatio times further.
+//
+// Swing points and BOS events depend only on the lookback; they are computed once
+// per lookback and shared by every configuration that uses it.
+class ParameterSweep {
+public:
+    ParameterSweep(const CandleSeries& candles, const BacktestConfig& backtestConfig = BacktestConfig());
+    ~ParameterSweep();
+
+    // Backtest every configuration on `threads` workers (0 = one per core) with work
+    // stealing; results are ranked by net profit, then by smaller drawdown.
+    std::vector<SweepResult> run(const std::vector<SweepParams>& configs, size_t threads = 0) const;
+
+    // Orders the strategy places for one configuration
+    std::vector<Order> ordersFor(const SweepParams& params) const;
+
+    // Ranked CSV table
+    static bool writeTable(const std::string& path, const std::vector<SweepResult>& results);
+
+private:
+    struct LookbackCache;
+    struct ATRCache;
+
+    const CandleSeries& candles;
+    BacktestConfig backtestConfig;
+    std::vector<std::pair<OBZone, std::string>> orderBlocks;  // parameter independent
+    std::vector<size_t> orderBlockIndex;                       // bar of each order block
+
+    mutable std::mutex cacheMutex;
+    mutable std::map<int, std::unique_ptr<LookbackCache>> caches;
+    mutable std::map<size_t, std::unique_ptr<ATRCache>> atrCaches;
+
+    const LookbackCache& cacheFor(int lookback) const;
+    const std::vector<double>& atrFor(size_t period) const;
+    SweepResult evaluate(const SweepParams& params) const;
+};
+
+#endif // PARAMETERSWEEP_H
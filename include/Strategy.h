@@ -3,35 +3,62 @@
 #include <vector>
 #include <string>
 #include "Candle.h"
+#include "CandleSeries.h"
 #include "MarketStructure.h"
 #include "OrderBlock.h"
 
+namespace spdlog { class logger; }
+
 class Strategy {
 public:
-    // Constructor to initialize candles, CHoCH, and BOS points
-    Strategy(const std::vector<Candle>& candles, const std::vector<StructurePoint>& choch, const std::vector<StructurePoint>& bos);
+    // Borrows the candles, the swing points and the CHoCH/BOS points detected from
+    // them (with `swingLookback`) without copying them; they must outlive run().
+    // Progress goes to `log` (null = default logger).
+    Strategy(const std::vector<Candle>& candles, const std::vector<StructurePoint>& swings,
+             const std::vector<StructurePoint>& choch, const std::vector<StructurePoint>& bos,
+             int swingLookback = 2, spdlog::logger* log = nullptr);
+    Strategy(const CandleSeries& candles, const std::vector<StructurePoint>& swings,
+             const std::vector<StructurePoint>& choch, const std::vector<StructurePoint>& bos,
+             int swingLookback = 2, spdlog::logger* log = nullptr);
+
+    // A temporary history would be gone before run()
+    Strategy(std::vector<Candle>&&, const std::vector<StructurePoint>&, const std::vector<StructurePoint>&,
+             const std::vector<StructurePoint>&, int = 2, spdlog::logger* = nullptr) = delete;
+    Strategy(CandleSeries&&, const std::vector<StructurePoint>&, const std::vector<StructurePoint>&,
+             const std::vector<StructurePoint>&, int = 2, spdlog::logger* = nullptr) = delete;
 
-    // Main strategy runner
+    // Main strategy runner: detects order blocks once, confirms them with
+    // structure and generates an order for each confirmed block. Each order's
+    // activation timestamp is the bar its confirmation can first be detected on:
+    // a CHoCH at bar j needs the swings before j (known at j + swingLookback - 1),
+    // a BOS needs the swing it breaks (known at swing index + swingLookback).
+    // Blocks whose confirmation is not known by the last bar get no order.
     void run();
 
     // Method to get generated orders
     const std::vector<Order>& getOrders() const;
 
 private:
-    std::vector<Candle> candles;
-    std::vector<StructurePoint> choch;
-    std::vector<StructurePoint> bos;
+    const std::vector<Candle>* candles = nullptr;   // one of candles / series is set
+    const CandleSeries* series = nullptr;
+    const std::vector<StructurePoint>* swings;
+    const std::vector<StructurePoint>* choch;
+    const std::vector<StructurePoint>* bos;
+    int swingLookback;
+    spdlog::logger* log;
     std::vector<Order> orders;
 
-    // Detect order blocks and generate orders
-    void detectAndGenerateOrders();
+    // Detect, confirm and generate orders over either candle layout
+    template <typename Series>
+    void detectConfirmAndGenerate(const Series& candles);
+
+    // Bar (index) at which a BOS at each bar becomes known; SIZE_MAX where there is none
+    template <typename Series>
+    std::vector<size_t> bosKnownAt(const Series& candles) const;
 
     // Generate a buy order for bullish order blocks
-    void generateBuyOrder(const OBZone& ob);
+    void generateBuyOrder(const OBZone& ob, int64_t activationTimestamp);
 
     // Generate a sell order for bearish order blocks
-    void generateSellOrder(const OBZone& ob);
-
-    // Filter and confirm order blocks with structure points (CHoCH, BOS)
-    void confirmAndFilterOrderBlocks();
+    void generateSellOrder(const OBZone& ob, int64_t activationTimestamp);
 };
@@ -1,6 +1,7 @@
 #pragma once
 #include <vector>
 #include "Candle.h"
+#include "CandleSeries.h"
 #include "MarketStructure.h"
 #include <OrderBlock.h>
 
@@ -11,4 +12,10 @@ namespace StructureUtils
         const std::vector<StructurePoint> &chochPoints,
         const std::vector<StructurePoint> &trendBreaks,
         const std::vector<Candle> &candles);
+
+    std::vector<StructureEvent> gatherStructureEvents(
+        const std::vector<StructurePoint> &bosPoints,
+        const std::vector<StructurePoint> &chochPoints,
+        const std::vector<StructurePoint> &trendBreaks,
+        const CandleSeries &candles);
 }
@@ -0,0 +1,43 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads draining a shared FIFO task queue.
+class ThreadPool {
+public:
+    // 0 threads = std::thread::hardware_concurrency()
+    explicit ThreadPool(size_t threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(std::function<void()> task);
+
+    // Block until every submitted task has finished. Rethrows the first
+    // exception a task let escape since the previous wait().
+    void wait();
+
+    size_t size() const { return workers.size(); }
+
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable taskReady;
+    std::condition_variable allDone;
+    size_t pending = 0;  // queued + running
+    bool stopping = false;
+    std::exception_ptr firstError;
+
+    void workerLoop();
+};
+
+#endif // THREADPOOL_H
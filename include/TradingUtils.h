@@ -2,9 +2,12 @@
 #include <vector>
 #include <string>
 #include "Candle.h"
+#include "CandleSeries.h"
 #include "OrderBlock.h"
 #include "MarketStructure.h" 
 
+namespace spdlog { class logger; }
+
 namespace TradingUtils
 {
     // Existing function based on candle closes
@@ -15,10 +18,18 @@ namespace TradingUtils
 
     double calculateATR(const std::vector<Candle> &candles, size_t period = 14);
 
+    // Columnar overloads
+    std::string getTrendDirection(const CandleSeries &candles);
+
+    // ATR at the last bar only; Indicators::atrSeries gives it at every bar
+    double calculateATR(const CandleSeries &candles, size_t period = 14);
+
     void logRiskManagement(double entryPrice, const OBZone &orderBlock, bool isBuy, double atr,
-                           double riskATRMultiplier = 1.5, double rewardRiskRatioTP2 = 2.0, double rewardRiskRatioTP1 = 1.0);
+                           double riskATRMultiplier = 1.5, double rewardRiskRatioTP2 = 2.0, double rewardRiskRatioTP1 = 1.0,
+                           spdlog::logger *log = nullptr);
 
     OrderBlock createOrderBlockFromZone(const OBZone &obZone, const std::string &typeStr);
 
-    void logCandleWithDelta(const Candle &curr, const Candle *prev = nullptr);
+    // Logging helpers write to `log`, or the default logger when it is null
+    void logCandleWithDelta(const Candle &curr, const Candle *prev = nullptr, spdlog::logger *log = nullptr);
 }
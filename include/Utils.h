@@ -0,0 +1,19 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace Utils
+{
+    // Parse a bar date into UTC epoch seconds. Accepted layouts:
+    //   "MM/DD/YYYY[ HH:MM[:SS]]"   (CSV exports in data/)
+    //   "YYYY-MM-DD[ HH:MM[:SS]]"   (ISO, also used for API bars)
+    // Surrounding whitespace is ignored. Returns false on malformed input.
+    bool parseTimestamp(std::string_view text, int64_t &out);
+
+    // Format UTC epoch seconds as "YYYY-MM-DD HH:MM:SS" (logging only)
+    std::string formatTimestamp(int64_t timestamp);
+
+    // Days since 1970-01-01 for a proleptic Gregorian date
+    int64_t daysFromCivil(int64_t year, unsigned month, unsigned day);
+}
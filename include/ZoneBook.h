@@ -0,0 +1,105 @@
+#ifndef ZONEBOOK_H
+#define ZONEBOOK_H
+
+#include <cstdint>
+#include <deque>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include "CandleSeries.h"
+#include "OrderBlock.h"
+#include "ZoneIndex.h"
+
+// Lifecycle of an order block after it is confirmed:
+//   Fresh        price has not come back to the zone
+//   Touched      a bar's range reached the zone but closed outside it
+//   Mitigated    a bar closed inside the zone (the entry fired); the zone is spent
+//   Invalidated  a bar closed beyond the zone's far edge (below a bullish zone,
+//                above a bearish one), or the zone outlived maxAgeBars
+// Fresh and touched zones are live and tradable; the other two are evicted.
+enum class ZoneState {
+    Fresh,
+    Touched,
+    Mitigated,
+    Invalidated
+};
+
+struct BookZone {
+    OBZone zone;
+    ZoneState state = ZoneState::Fresh;
+    size_t formedAt = 0;     // bar index of the order-block candle
+    size_t touches = 0;
+    size_t lastTouch = 0;    // bar index of the latest touch
+};
+
+// A zone that was added, touched for the first time or evicted, as it was afterwards
+struct ZoneChange {
+    BookZone zone;
+    size_t index;            // bar that caused the change
+};
+
+// Keeps every order block alive across bars, not just the newest one, and moves
+// each through the states above as bars arrive. A bar only visits the zones its
+// [low, high] range overlaps (through ZoneIndex) and the zones it invalidates, so
+// its cost is O(log n + zones it changes) however many zones have been seen.
+class ZoneBook {
+public:
+    // maxAgeBars = 0 keeps zones until price mitigates or invalidates them
+    explicit ZoneBook(size_t maxAgeBars = 0) : maxAgeBars(maxAgeBars) {}
+
+    // Process bar i of `candles` (bars must arrive in order from 0): update the live
+    // zones with it, then add the order blocks it confirms (formed at bar i - 2)
+    void update(const CandleSeries& candles, size_t i);
+
+    // Track an externally detected zone from the next update() on
+    ZoneIndex::Id add(const OBZone& zone, size_t formedAt);
+
+    void reset();
+
+    size_t barCount() const { return bars; }
+    size_t size() const { return index.size(); }
+    size_t freshCount() const { return fresh; }
+    size_t touchedCount() const { return index.size() - fresh; }
+
+    // What the latest update() added, touched for the first time or evicted
+    const std::vector<ZoneChange>& lastChanges() const { return changes; }
+
+    // Appends the live zones that contain `price`
+    void tradableAt(double price, std::vector<BookZone>& out) const;
+
+    // Calls f(const BookZone&) for every live zone
+    template <typename F>
+    void forEachLive(F&& f) const {
+        for (const auto& slot : slots) {
+            if (slot.live) f(slot.zone);
+        }
+    }
+
+    static std::string stateName(ZoneState state);
+
+private:
+    struct Slot {
+        BookZone zone;
+        uint64_t serial = 0;     // tells a reused slot apart in `ageQueue`
+        bool live = false;
+    };
+
+    size_t maxAgeBars;
+    ZoneIndex index;
+    std::vector<Slot> slots;                              // by ZoneIndex id
+    std::set<std::pair<double, ZoneIndex::Id>> bullish;   // by lower bound
+    std::set<std::pair<double, ZoneIndex::Id>> bearish;   // by upper bound
+    std::deque<std::pair<uint64_t, ZoneIndex::Id>> ageQueue;  // formation order
+    uint64_t nextSerial = 0;
+    size_t fresh = 0;
+    size_t bars = 0;
+
+    std::vector<ZoneChange> changes;
+    std::vector<ZoneIndex::Id> touched;
+    std::vector<std::pair<OBZone, std::string>> confirmed;
+
+    void evict(ZoneIndex::Id id, ZoneState state, size_t i);
+};
+
+#endif // ZONEBOOK_H
@@ -0,0 +1,78 @@
+#ifndef ZONEINDEX_H
+#define ZONEINDEX_H
+
+#include <cstdint>
+#include <vector>
+#include "OrderBlock.h"
+
+// Interval index over order-block zones keyed on [min(bottom, top), max(bottom, top)]
+// (the same bounds the entry search uses). A treap ordered by the lower bound and
+// augmented with each subtree's highest upper bound: insert and remove are
+// O(log n) expected, price and range queries O(log n + matches).
+//
+// Ids are slots in the index and are reused after a zone is removed.
+class ZoneIndex {
+public:
+    using Id = uint32_t;
+
+    Id insert(const OBZone& zone);
+    bool remove(Id id);
+    void clear();
+
+    bool contains(Id id) const { return id < nodes.size() && nodes[id].live; }
+    const OBZone& zone(Id id) const { return nodes[id].zone; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    // Appends the ids of zones with low <= price <= high
+    void containing(double price, std::vector<Id>& out) const { overlapping(price, price, out); }
+
+    // Appends the ids of zones that intersect [low, high], e.g. the zones a candle's
+    // range touched. Ids come out in ascending order of the zones' lower bound.
+    void overlapping(double low, double high, std::vector<Id>& out) const;
+
+    // Calls f(id) for every zone that intersects [low, high], without allocating
+    template <typename F>
+    void forEachOverlapping(double low, double high, F&& f) const {
+        visit(root, low, high, f);
+    }
+
+private:
+    static constexpr int32_t kNil = -1;
+
+    struct Node {
+        OBZone zone;
+        double low;
+        double high;
+        double maxHigh;     // highest `high` in this subtree
+        uint64_t priority;
+        int32_t left = kNil;
+        int32_t right = kNil;
+        bool live = false;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<Id> freeIds;
+    int32_t root = kNil;
+    size_t count = 0;
+    uint64_t rngState = 0x9E3779B97F4A7C15ULL;
+
+    bool less(int32_t a, int32_t b) const;
+    void pull(int32_t t);
+    void split(int32_t t, int32_t key, int32_t& l, int32_t& r);
+    int32_t merge(int32_t l, int32_t r);
+    int32_t erase(int32_t t, int32_t key);
+
+    template <typename F>
+    void visit(int32_t t, double low, double high, F& f) const {
+        while (t != kNil && nodes[t].maxHigh >= low) {
+            const Node& n = nodes[t];
+            visit(n.left, low, high, f);
+            if (n.low > high) return;  // everything to the right starts higher still
+            if (n.high >= low) f(static_cast<Id>(t));
+            t = n.right;
+        }
+    }
+};
+
+#endif // ZONEINDEX_H
@@ -0,0 +1,278 @@
+#include "AsyncLog.h"
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <spdlog/spdlog.h>
+#include <spdlog/pattern_formatter.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
+
+// ==============================
+// AsyncLogQueue
+// ==============================
+
+// Bounded MPMC ring after Vyukov: a cell's sequence says whose turn it is
+// (== pos: free for the producer claiming pos, == pos + 1: holds record pos).
+
+AsyncLogQueue::AsyncLogQueue(size_t capacity, LogOverflow overflow) : overflow(overflow) {
+    size_t size = 2;
+    while (size < capacity) size <<= 1;
+    cells = std::vector<Cell>(size);
+    for (size_t i = 0; i < size; ++i) cells[i].sequence.store(i, std::memory_order_relaxed);
+    mask = size - 1;
+
+    writer = std::thread([this] { writerLoop(); });
+}
+
+AsyncLogQueue::~AsyncLogQueue() {
+    stop();
+}
+
+template <typename Fill>
+bool AsyncLogQueue::enqueue(Fill fill) {
+    // Registered before `stopping` is read, so the writer's final drain waits for us
+    struct Producer {
+        std::atomic<int>& count;
+        explicit Producer(std::atomic<int>& c) : count(c) { count.fetch_add(1); }
+        ~Producer() { count.fetch_sub(1); }
+    } producer(producers);
+    if (stopping.load()) return false;
+
+    size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    Cell* cell;
+    for (;;) {
+        cell = &cells[pos & mask];
+        const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            // Full: the writer still holds the record from one lap ago
+            if (overflow == LogOverflow::Drop || stopping.load(std::memory_order_acquire)) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            wakeWriter();
+            std::this_thread::yield();
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        } else {
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    fill(cell->record);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (writerSleeping.load(std::memory_order_relaxed)) wakeWriter();
+    return true;
+}
+
+bool AsyncLogQueue::push(const std::shared_ptr<spdlog::sinks::sink>& sink, const spdlog::details::log_msg& msg) {
+    return enqueue([&](Record& record) {
+        record.sink = sink;
+        record.time = msg.time;
+        record.level = msg.level;
+        record.threadId = msg.thread_id;
+        record.name.assign(msg.logger_name.data(), msg.logger_name.size());
+        record.payload.assign(msg.payload.data(), msg.payload.size());
+        record.flush = false;
+    });
+}
+
+bool AsyncLogQueue::pushFlush(const std::shared_ptr<spdlog::sinks::sink>& sink) {
+    return enqueue([&](Record& record) {
+        record.sink = sink;
+        record.flush = true;
+    });
+}
+
+void AsyncLogQueue::stop() {
+    std::lock_guard<std::mutex> lock(stopMutex);
+    if (!writer.joinable()) return;
+
+    stopping.store(true);
+    wakeWriter();
+    writer.join();
+}
+
+void AsyncLogQueue::wakeWriter() {
+    std::lock_guard<std::mutex> lock(wakeMutex);
+    wake.notify_one();
+}
+
+bool AsyncLogQueue::drainOne() {
+    Cell& cell = cells[dequeuePos & mask];
+    if (cell.sequence.load(std::memory_order_acquire) != dequeuePos + 1) return false;
+
+    Record& record = cell.record;
+    if (record.flush) {
+        record.sink->flush();
+    } else {
+        spdlog::details::log_msg msg(record.time, spdlog::source_loc{}, record.name, record.level, record.payload);
+        msg.thread_id = record.threadId;
+        record.sink->log(msg);
+    }
+    record.sink.reset();
+
+    // Hand the cell (and its string capacity) back to the producer one lap ahead
+    cell.sequence.store(dequeuePos + mask + 1, std::memory_order_release);
+    ++dequeuePos;
+    return true;
+}
+
+void AsyncLogQueue::writerLoop() {
+    uint64_t reportedDrops = 0;
+    for (;;) {
+        bool wrote = false;
+        while (drainOne()) wrote = true;
+
+        const uint64_t drops = dropped.load(std::memory_order_relaxed);
+        if (drops != reportedDrops) {
+            std::fprintf(stderr, "[async log] %llu message(s) dropped, queue full\n",
+                         static_cast<unsigned long long>(drops - reportedDrops));
+            reportedDrops = drops;
+        }
+        if (wrote) continue;
+
+        // Stopped: finish once no producer is still filling a slot
+        if (stopping.load()) {
+            if (producers.load() == 0 && enqueuePos.load() == dequeuePos) break;
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        writerSleeping.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const bool empty = cells[dequeuePos & mask].sequence.load(std::memory_order_acquire) != dequeuePos + 1;
+        if (empty && !stopping.load(std::memory_order_acquire)) {
+            wake.wait_for(lock, std::chrono::milliseconds(100));
+        }
+        writerSleeping.store(false, std::memory_order_relaxed);
+    }
+}
+
+// ==============================
+// AsyncSink
+// ==============================
+
+AsyncSink::AsyncSink(std::shared_ptr<AsyncLogQueue> queue, spdlog::sink_ptr target)
+    : queue(std::move(queue)), target(std::move(target)) {}
+
+void AsyncSink::log(const spdlog::details::log_msg& msg) {
+    if (!queue->push(target, msg) && !queue->running()) target->log(msg);  // after AsyncLog::stop()
+}
+
+void AsyncSink::flush() {
+    if (!queue->pushFlush(target) && !queue->running()) target->flush();
+}
+
+void AsyncSink::set_pattern(const std::string& pattern) {
+    target->set_pattern(pattern);
+}
+
+void AsyncSink::set_formatter(std::unique_ptr<spdlog::formatter> formatter) {
+    target->set_formatter(std::move(formatter));
+}
+
+// ==============================
+// JsonLogFormatter
+// ==============================
+
+namespace {
+
+void appendEscaped(spdlog::memory_buf_t& dest, spdlog::string_view_t text) {
+    static const char hex[] = "0123456789abcdef";
+    for (char c : text) {
+        switch (c) {
+            case '"': dest.append(spdlog::string_view_t("\\\"")); break;
+            case '\\': dest.append(spdlog::string_view_t("\\\\")); break;
+            case '\n': dest.append(spdlog::string_view_t("\\n")); break;
+            case '\r': dest.append(spdlog::string_view_t("\\r")); break;
+            case '\t': dest.append(spdlog::string_view_t("\\t")); break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    const char escape[] = {'\\', 'u', '0', '0', hex[(c >> 4) & 0xF], hex[c & 0xF]};
+                    dest.append(escape, escape + sizeof(escape));
+                } else {
+                    dest.push_back(c);
+                }
+        }
+    }
+}
+
+} // namespace
+
+void JsonLogFormatter::format(const spdlog::details::log_msg& msg, spdlog::memory_buf_t& dest) {
+    const auto seconds = std::chrono::time_point_cast<std::chrono::seconds>(msg.time);
+    const auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(msg.time - seconds).count();
+    const std::time_t t = spdlog::log_clock::to_time_t(msg.time);
+    std::tm tm{};
+    gmtime_r(&t, &tm);
+
+    char time[32];
+    const int length = std::snprintf(time, sizeof(time), "%04d-%02d-%02dT%02d:%02d:%02d.%03dZ", tm.tm_year + 1900,
+                                     tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec,
+                                     static_cast<int>(millis));
+
+    dest.append(spdlog::string_view_t("{\"time\":\""));
+    dest.append(time, time + length);
+    dest.append(spdlog::string_view_t("\",\"level\":\""));
+    const auto& level = spdlog::level::to_string_view(msg.level);
+    dest.append(level.data(), level.data() + level.size());
+    dest.append(spdlog::string_view_t("\",\"logger\":\""));
+    appendEscaped(dest, msg.logger_name);
+    dest.append(spdlog::string_view_t("\",\"msg\":\""));
+    appendEscaped(dest, msg.payload);
+    dest.append(spdlog::string_view_t("\"}\n"));
+}
+
+std::unique_ptr<spdlog::formatter> JsonLogFormatter::clone() const {
+    return std::make_unique<JsonLogFormatter>();
+}
+
+// ==============================
+// AsyncLog
+// ==============================
+
+namespace {
+
+std::mutex asyncMutex;
+std::shared_ptr<AsyncLogQueue> asyncQueue;
+bool jsonFormat = false;
+
+} // namespace
+
+void AsyncLog::start(const Options& options) {
+    {
+        std::lock_guard<std::mutex> lock(asyncMutex);
+        if (asyncQueue) return;
+        asyncQueue = std::make_shared<AsyncLogQueue>(options.capacity, options.overflow);
+        jsonFormat = options.json;
+    }
+
+    auto logger = spdlog::default_logger();
+    auto replacement = std::make_shared<spdlog::logger>(logger->name(), consoleSink("%^%l%$ [%Y-%m-%d %H:%M:%S] %v"));
+    replacement->set_level(logger->level());
+    replacement->flush_on(logger->flush_level());
+    spdlog::set_default_logger(replacement);
+}
+
+spdlog::sink_ptr AsyncLog::consoleSink(const std::string& pattern) {
+    auto console = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+
+    std::lock_guard<std::mutex> lock(asyncMutex);
+    if (jsonFormat) console->set_formatter(std::make_unique<JsonLogFormatter>());
+    else console->set_pattern(pattern);
+    if (!asyncQueue) return console;
+    return std::make_shared<AsyncSink>(asyncQueue, console);
+}
+
+void AsyncLog::stop() {
+    std::shared_ptr<AsyncLogQueue> queue;
+    {
+        std::lock_guard<std::mutex> lock(asyncMutex);
+        queue = asyncQueue;
+    }
+    if (queue) queue->stop();
+}
@@ -0,0 +1,175 @@
+#include "Backtest.h"
+#include "Indicators.h"
+#include "Strategy.h"
+#include <algorithm>
+
+namespace {
+
+struct WorkingOrder {
+    size_t activeFrom;
+    size_t expiresAt;   // first bar the order is no longer valid
+    bool isBuy;
+    double entry;
+    double stopLoss;
+    double takeProfit;
+};
+
+struct Position {
+    size_t entryIndex;
+    bool isBuy;
+    double entry;
+    double stopLoss;
+    double takeProfit;
+};
+
+// Whether a position exits on this bar, and at what price.
+// `reference` is the open, or the fill price on the bar the position was opened.
+bool exitsAt(const Position& p, double reference, double high, double low, double& price, ExitReason& reason) {
+    if (p.isBuy) {
+        if (reference <= p.stopLoss) { reason = ExitReason::StopLoss; price = reference; return true; }
+        if (reference >= p.takeProfit) { reason = ExitReason::TakeProfit; price = reference; return true; }
+        if (low <= p.stopLoss) { reason = ExitReason::StopLoss; price = p.stopLoss; return true; }
+        if (high >= p.takeProfit) { reason = ExitReason::TakeProfit; price = p.takeProfit; return true; }
+    } else {
+        if (reference >= p.stopLoss) { reason = ExitReason::StopLoss; price = reference; return true; }
+        if (reference <= p.takeProfit) { reason = ExitReason::TakeProfit; price = reference; return true; }
+        if (high >= p.stopLoss) { reason = ExitReason::StopLoss; price = p.stopLoss; return true; }
+        if (low <= p.takeProfit) { reason = ExitReason::TakeProfit; price = p.takeProfit; return true; }
+    }
+    return false;
+}
+
+} // namespace
+
+Backtest::Backtest(const BacktestConfig& config) : config(config) {}
+
+BacktestResult Backtest::run(const CandleSeries& candles, Strategy& strategy) const {
+    strategy.run();
+    return run(candles, strategy.getOrders());
+}
+
+BacktestResult Backtest::run(const CandleSeries& candles, const std::vector<Order>& orders) const {
+    BacktestResult result;
+    const size_t n = candles.size();
+    if (config.atrPeriod > 0) result.atr = Indicators::atrSeries(candles, config.atrPeriod);
+
+    // Schedule: every order with the first bar it may fill on
+    std::vector<WorkingOrder> schedule;
+    schedule.reserve(orders.size());
+    for (const auto& order : orders) {
+        if (order.getStatus() != Order::Status::PENDING) continue;
+
+        const bool isBuy = order.getType() == Order::Type::BUY;
+        const double entry = order.getEntryPrice();
+        const bool levelsValid = isBuy ? (order.getStopLoss() < entry && entry < order.getTakeProfit())
+                                       : (order.getTakeProfit() < entry && entry < order.getStopLoss());
+        auto it = std::lower_bound(candles.timestamp.begin(), candles.timestamp.end(), order.getOrderTimestamp());
+        if (!levelsValid || it == candles.timestamp.end() || *it != order.getOrderTimestamp()) {
+            ++result.ordersRejected;
+            continue;
+        }
+
+        // Known at the close of the later of the OB's confirmation bars and the signal's own bar
+        const size_t orderBar = static_cast<size_t>(it - candles.timestamp.begin());
+        const auto known = std::lower_bound(it, candles.timestamp.end(), order.getActivationTimestamp());
+        const size_t activeFrom = std::max(orderBar + config.confirmationBars,
+                                           static_cast<size_t>(known - candles.timestamp.begin())) + 1;
+        if (activeFrom >= n) {
+            ++result.ordersUnfilled;
+            continue;
+        }
+        const size_t expiresAt = config.orderExpiryBars ? activeFrom + config.orderExpiryBars : n;
+        schedule.push_back({activeFrom, expiresAt, isBuy, entry, order.getStopLoss(), order.getTakeProfit()});
+    }
+    std::stable_sort(schedule.begin(), schedule.end(),
+                     [](const WorkingOrder& a, const WorkingOrder& b) { return a.activeFrom < b.activeFrom; });
+
+    std::vector<WorkingOrder> working;
+    std::vector<Position> open;
+    working.reserve(schedule.size());
+    open.reserve(schedule.size());
+    result.trades.reserve(schedule.size());
+    result.equity.resize(n);
+
+    const double* opens = candles.open.data();
+    const double* highs = candles.high.data();
+    const double* lows = candles.low.data();
+    const double* closes = candles.close.data();
+    const int64_t* timestamps = candles.timestamp.data();
+    const double units = config.positionSize;
+
+    auto closePosition = [&](const Position& p, size_t i, double price, ExitReason reason) {
+        const double pnl = (p.isBuy ? price - p.entry : p.entry - price) * units - config.commissionPerTrade;
+        result.trades.push_back({p.isBuy ? Order::Type::BUY : Order::Type::SELL, p.entryIndex, i,
+                                 timestamps[p.entryIndex], timestamps[i], p.entry, price,
+                                 p.stopLoss, p.takeProfit, pnl, reason});
+        if (pnl > 0) ++result.wins;
+        else ++result.losses;
+        return pnl;
+    };
+
+    double cash = config.initialCapital;
+    double peak = cash;
+    size_t next = 0;
+
+    for (size_t i = 0; i < n; ++i) {
+        const double o = opens[i], h = highs[i], l = lows[i], c = closes[i];
+
+        for (; next < schedule.size() && schedule[next].activeFrom <= i; ++next) {
+            working.push_back(schedule[next]);
+        }
+
+        // Working orders: expire or fill (compacted in place, keeping submission order)
+        const size_t openBefore = open.size();
+        size_t keep = 0;
+        for (size_t k = 0; k < working.size(); ++k) {
+            const WorkingOrder& w = working[k];
+            if (i >= w.expiresAt) {
+                ++result.ordersExpired;
+                continue;
+            }
+            if (w.isBuy ? (l <= w.entry) : (h >= w.entry)) {
+                const double fill = w.isBuy ? std::min(o, w.entry) : std::max(o, w.entry);
+                open.push_back({i, w.isBuy, fill, w.stopLoss, w.takeProfit});
+                ++result.ordersFilled;
+                continue;
+            }
+            working[keep++] = w;
+        }
+        working.resize(keep);
+
+        // Open positions: exits, then mark the rest to the close
+        double unrealized = 0.0;
+        keep = 0;
+        for (size_t k = 0; k < open.size(); ++k) {
+            const Position& p = open[k];
+            double price;
+            ExitReason reason;
+            if (exitsAt(p, k >= openBefore ? p.entry : o, h, l, price, reason)) {
+                cash += closePosition(p, i, price, reason);
+                continue;
+            }
+            unrealized += (p.isBuy ? c - p.entry : p.entry - c) * units;
+            open[keep++] = p;
+        }
+        open.resize(keep);
+
+        const double equity = cash + unrealized;
+        result.equity[i] = equity;
+        peak = std::max(peak, equity);
+        result.maxDrawdown = std::max(result.maxDrawdown, peak - equity);
+    }
+
+    // Whatever is still open is closed at the last close
+    for (const auto& p : open) {
+        cash += closePosition(p, n - 1, closes[n - 1], ExitReason::EndOfData);
+    }
+    if (!open.empty()) {
+        result.equity[n - 1] = cash;
+        result.maxDrawdown = std::max(result.maxDrawdown, peak - cash);
+    }
+
+    result.ordersUnfilled += working.size() + (schedule.size() - next);
+    result.finalEquity = cash;
+    return result;
+}
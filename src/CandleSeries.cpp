@@ -0,0 +1,77 @@
+#include "CandleSeries.h"
+#include <algorithm>
+#include <cstddef>
+
+CandleSeries::CandleSeries(const std::vector<Candle>& candles) {
+    reserve(candles.size());
+    for (const auto& candle : candles) {
+        push_back(candle);
+    }
+}
+
+void CandleSeries::reserve(size_t n) {
+    open.reserve(n);
+    high.reserve(n);
+    low.reserve(n);
+    close.reserve(n);
+    volume.reserve(n);
+    changePercent.reserve(n);
+    timestamp.reserve(n);
+}
+
+void CandleSeries::clear() {
+    open.clear();
+    high.clear();
+    low.clear();
+    close.clear();
+    volume.clear();
+    changePercent.clear();
+    timestamp.clear();
+}
+
+void CandleSeries::push_back(const Candle& candle) {
+    open.push_back(candle.open);
+    high.push_back(candle.high);
+    low.push_back(candle.low);
+    close.push_back(candle.close);
+    volume.push_back(candle.volume);
+    changePercent.push_back(candle.changePercent);
+    timestamp.push_back(candle.timestamp);
+}
+
+void CandleSeries::truncate(size_t n) {
+    if (n >= size()) return;
+    open.resize(n);
+    high.resize(n);
+    low.resize(n);
+    close.resize(n);
+    volume.resize(n);
+    changePercent.resize(n);
+    timestamp.resize(n);
+}
+
+void CandleSeries::dropFront(size_t n) {
+    n = std::min(n, size());
+    if (n == 0) return;
+    const auto drop = [n](auto& column) { column.erase(column.begin(), column.begin() + static_cast<std::ptrdiff_t>(n)); };
+    drop(open);
+    drop(high);
+    drop(low);
+    drop(close);
+    drop(volume);
+    drop(changePercent);
+    drop(timestamp);
+}
+
+Candle CandleSeries::at(size_t i) const {
+    return Candle(open[i], high[i], low[i], close[i], volume[i], timestamp[i], changePercent[i]);
+}
+
+std::vector<Candle> CandleSeries::toCandles() const {
+    std::vector<Candle> candles;
+    candles.reserve(size());
+    for (size_t i = 0; i < size(); ++i) {
+        candles.push_back(at(i));
+    }
+    return candles;
+}
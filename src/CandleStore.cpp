@@ -0,0 +1,165 @@
+#include "CandleStore.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <spdlog/spdlog.h>
+
+namespace {
+
+constexpr char kMagic[8] = {'T', 'S', 'C', 'A', 'N', 'D', 'L', 'E'};
+constexpr uint32_t kVersion = 1;
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    uint64_t count;
+    char symbol[24];
+    char timeframe[16];
+};
+static_assert(sizeof(FileHeader) == 64, "CandleStore header must stay 64 bytes");
+
+// Bytes per bar across all column blocks
+static_assert(sizeof(int) == sizeof(int32_t), "CandleSeries::volume is stored as int32");
+
+constexpr uint64_t kBarBytes = sizeof(int64_t) + 5 * sizeof(double) + sizeof(int32_t);
+
+template <typename T>
+void writeColumn(std::ofstream& out, const std::vector<T>& column) {
+    out.write(reinterpret_cast<const char*>(column.data()), static_cast<std::streamsize>(column.size() * sizeof(T)));
+}
+
+template <typename T>
+const char* readColumn(const char* src, std::vector<T>& column, size_t count) {
+    column.resize(count);
+    std::memcpy(column.data(), src, count * sizeof(T));
+    return src + count * sizeof(T);
+}
+
+void copyField(char* dst, size_t size, const std::string& value) {
+    std::memset(dst, 0, size);
+    std::memcpy(dst, value.data(), std::min(value.size(), size - 1));
+}
+
+std::string fieldString(const char* src, size_t size) {
+    return std::string(src, strnlen(src, size));
+}
+
+// Validate the header against the file size; the bar count is what makes the columns addressable
+bool checkHeader(const MappedFile& file, const std::string& path, FileHeader& header) {
+    if (file.size() < sizeof(FileHeader)) {
+        spdlog::error("Not a candle store (too short): {}", path);
+        return false;
+    }
+    std::memcpy(&header, file.data(), sizeof(FileHeader));
+
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+        spdlog::error("Not a candle store (bad magic): {}", path);
+        return false;
+    }
+    if (header.version != kVersion || header.headerSize != sizeof(FileHeader)) {
+        spdlog::error("Unsupported candle store version or byte order: {}", path);
+        return false;
+    }
+    if (header.count > (file.size() - sizeof(FileHeader)) / kBarBytes ||
+        file.size() != sizeof(FileHeader) + header.count * kBarBytes) {
+        spdlog::error("Candle store size does not match its header: {}", path);
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+namespace CandleStore
+{
+
+bool write(const std::string& path, const CandleSeries& candles, const std::string& symbol, const std::string& timeframe) {
+    FileHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.headerSize = sizeof(FileHeader);
+    header.count = candles.size();
+    copyField(header.symbol, sizeof(header.symbol), symbol);
+    copyField(header.timeframe, sizeof(header.timeframe), timeframe);
+
+    const std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            spdlog::error("Error opening file for writing: {}", tmpPath);
+            return false;
+        }
+
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        writeColumn(out, candles.timestamp);
+        writeColumn(out, candles.open);
+        writeColumn(out, candles.high);
+        writeColumn(out, candles.low);
+        writeColumn(out, candles.close);
+        writeColumn(out, candles.changePercent);
+        writeColumn(out, candles.volume);
+
+        if (!out.flush()) {
+            spdlog::error("Error writing file: {}", tmpPath);
+            std::remove(tmpPath.c_str());
+            return false;
+        }
+    }
+
+    // Readers never see a half-written store
+    if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        spdlog::error("Error renaming {} to {}", tmpPath, path);
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool read(const std::string& path, CandleSeries& candles, CandleStoreInfo* info) {
+    MappedFile file(path);
+    if (!file.isOpen()) {
+        spdlog::error("Error opening file: {}", path);
+        return false;
+    }
+
+    FileHeader header;
+    if (!checkHeader(file, path, header)) return false;
+
+    const size_t count = static_cast<size_t>(header.count);
+    const char* src = file.data() + sizeof(FileHeader);
+    src = readColumn(src, candles.timestamp, count);
+    src = readColumn(src, candles.open, count);
+    src = readColumn(src, candles.high, count);
+    src = readColumn(src, candles.low, count);
+    src = readColumn(src, candles.close, count);
+    src = readColumn(src, candles.changePercent, count);
+    readColumn(src, candles.volume, count);
+
+    if (info) {
+        info->symbol = fieldString(header.symbol, sizeof(header.symbol));
+        info->timeframe = fieldString(header.timeframe, sizeof(header.timeframe));
+        info->count = header.count;
+    }
+    return true;
+}
+
+bool readInfo(const std::string& path, CandleStoreInfo& info) {
+    MappedFile file(path);
+    if (!file.isOpen()) {
+        spdlog::error("Error opening file: {}", path);
+        return false;
+    }
+
+    FileHeader header;
+    if (!checkHeader(file, path, header)) return false;
+
+    info.symbol = fieldString(header.symbol, sizeof(header.symbol));
+    info.timeframe = fieldString(header.timeframe, sizeof(header.timeframe));
+    info.count = header.count;
+    return true;
+}
+
+} // namespace CandleStore
@@ -1,7 +1,8 @@
 #include "Config.h"
 #include <fstream>
-#include <nlohmann/json.hpp>
+#include "json.hpp"
 #include <spdlog/spdlog.h>
+#include <set>
 #include <stdexcept>
 
 using json = nlohmann::json;
@@ -15,16 +16,101 @@ Config Config::load(const std::string &filename)
     json configJson;
     file >> configJson;
 
-    for (const auto &field : {"csv_path", "data_source", "api_endpoint", "api_key"})
+    const bool hasInstruments = configJson.contains("instruments");
+
+    // The top-level source is required unless an instrument list replaces it
+    if (!hasInstruments)
+    {
+        for (const auto &field : {"csv_path", "data_source", "api_endpoint", "api_key"})
+        {
+            if (!configJson.contains(field))
+                throw std::runtime_error(std::string("Missing config field: ") + field);
+        }
+    }
+
+    Config config;
+    config.csv_path = configJson.value("csv_path", "");
+    config.data_source = configJson.value("data_source", "");
+    config.api_endpoint = configJson.value("api_endpoint", "");
+    config.api_key = configJson.value("api_key", "");
+
+    // Optional fields
+    config.csv_reader = configJson.value("csv_reader", config.csv_reader);
+    if (config.csv_reader != "stream" && config.csv_reader != "mmap" && config.csv_reader != "tail")
+        throw std::runtime_error("Invalid csv_reader (expected \"stream\", \"mmap\" or \"tail\"): " + config.csv_reader);
+
+    config.trendline_pair_span = configJson.value("trendline_pair_span", config.trendline_pair_span);
+    if (config.trendline_pair_span < 1)
+        throw std::runtime_error("trendline_pair_span must be at least 1");
+
+    config.analysis_mode = configJson.value("analysis_mode", config.analysis_mode);
+    if (config.analysis_mode != "full" && config.analysis_mode != "incremental")
+        throw std::runtime_error("Invalid analysis_mode (expected \"full\" or \"incremental\"): " + config.analysis_mode);
+
+    config.symbol = configJson.value("symbol", config.symbol);
+
+    config.worker_threads = configJson.value("worker_threads", config.worker_threads);
+    if (config.worker_threads < 0)
+        throw std::runtime_error("worker_threads must not be negative");
+
+    config.log_format = configJson.value("log_format", config.log_format);
+    if (config.log_format != "text" && config.log_format != "json")
+        throw std::runtime_error("Invalid log_format (expected \"text\" or \"json\"): " + config.log_format);
+
+    config.log_overflow = configJson.value("log_overflow", config.log_overflow);
+    if (config.log_overflow != "block" && config.log_overflow != "drop")
+        throw std::runtime_error("Invalid log_overflow (expected \"block\" or \"drop\"): " + config.log_overflow);
+
+    config.log_queue_size = configJson.value("log_queue_size", config.log_queue_size);
+    if (config.log_queue_size < 1)
+        throw std::runtime_error("log_queue_size must be at least 1");
+
+    config.api_cache_dir = configJson.value("api_cache_dir", config.api_cache_dir);
+
+    if (!hasInstruments)
+    {
+        config.instruments.push_back({config.symbol, config.csv_path, config.data_source, config.api_endpoint, config.api_key});
+        return config;
+    }
+
+    const json &list = configJson["instruments"];
+    if (!list.is_array() || list.empty())
+        throw std::runtime_error("instruments must be a non-empty array");
+
+    // Each entry names a symbol and its source; missing source fields fall back to the top level
+    std::set<std::string> seen;
+    for (const auto &entry : list)
     {
-        if (!configJson.contains(field))
-            throw std::runtime_error(std::string("Missing config field: ") + field);
+        if (!entry.is_object() || !entry.contains("symbol"))
+            throw std::runtime_error("Each instrument needs a symbol");
+
+        InstrumentConfig instrument{
+            entry["symbol"],
+            entry.value("csv_path", config.csv_path),
+            entry.value("data_source", config.data_source.empty() ? std::string("CSV") : config.data_source),
+            entry.value("api_endpoint", config.api_endpoint),
+            entry.value("api_key", config.api_key)
+        };
+
+        if (instrument.symbol.empty() || !seen.insert(instrument.symbol).second)
+            throw std::runtime_error("Instrument symbols must be unique and non-empty: " + instrument.symbol);
+        if (instrument.data_source == "API" ? instrument.api_endpoint.empty() : instrument.csv_path.empty())
+            throw std::runtime_error("Instrument " + instrument.symbol + " has no data location");
+
+        config.instruments.push_back(std::move(instrument));
     }
 
-    return Config{
-        configJson["csv_path"],
-        configJson["data_source"],
-        configJson["api_endpoint"],
-        configJson["api_key"]
-    };
+    return config;
+}
+
+Config Config::forInstrument(const InstrumentConfig &instrument) const
+{
+    Config single = *this;
+    single.csv_path = instrument.csv_path;
+    single.data_source = instrument.data_source;
+    single.api_endpoint = instrument.api_endpoint;
+    single.api_key = instrument.api_key;
+    single.symbol = instrument.symbol;
+    single.instruments = {instrument};
+    return single;
 }
@@ -1,16 +1,39 @@
 #include "DataReader.h"
+#include "MappedFile.h"
+#include "CandleStore.h"
+#include "KlineCache.h"
+#include "KlineFetcher.h"
+#include "Utils.h"
+#include <spdlog/spdlog.h>
 #include <fstream>
 #include <sstream>
-#include <iostream>
-#include <curl/curl.h>
-#include <iomanip>
-#include <ctime>
-#include "json.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <string_view>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+DataReader::DataReader(const std::string& filepath, const std::string& dataSource, const std::string& apiEndpoint, const std::string& apiKey,
+                       const std::string& csvReader, const std::string& apiCacheDir)
+    : filepath(filepath), dataSource(dataSource), apiEndpoint(apiEndpoint), apiKey(apiKey), csvReader(csvReader) {
+    if (dataSource == "API" && !apiCacheDir.empty()) {
+        if (KlineCache::supports(apiEndpoint)) {
+            cache = std::make_unique<KlineCache>(apiCacheDir, apiEndpoint);
+        } else {
+            logger()->warn("api_cache_dir ignored: the endpoint sets its own startTime/endTime");
+        }
+    }
+}
 
-using json = nlohmann::json;
+spdlog::logger* DataReader::logger() const {
+    return log ? log : spdlog::default_logger_raw();
+}
 
-DataReader::DataReader(const std::string& filepath, const std::string& dataSource, const std::string& apiEndpoint, const std::string& apiKey)
-    : filepath(filepath), dataSource(dataSource), apiEndpoint(apiEndpoint), apiKey(apiKey) {}
+DataReader::~DataReader() = default;
+DataReader::DataReader(DataReader&&) noexcept = default;
+DataReader& DataReader::operator=(DataReader&&) noexcept = default;
 
 // Helper function to trim leading/trailing whitespace
 std::string trim(const std::string& str) {
@@ -27,7 +50,7 @@ std::vector<Candle> DataReader::readCSV() {
     std::ifstream file(filepath);
 
     if (!file.is_open()) {
-        std::cerr << "Error opening file: " << filepath << std::endl;
+        logger()->error("Error opening file: {}", filepath);
         return candles;
     }
 
@@ -62,9 +85,12 @@ std::vector<Candle> DataReader::readCSV() {
         std::getline(ss, percentChangeStr);
 
         Candle candle;
-        candle.date = trim(date);
 
         try {
+            if (!Utils::parseTimestamp(date, candle.timestamp)) {
+                throw std::invalid_argument("unrecognized date: " + trim(date));
+            }
+
             candle.open = std::stod(trim(openStr));
             candle.high = std::stod(trim(highStr));
             candle.low = std::stod(trim(lowStr));
@@ -81,111 +107,328 @@ std::vector<Candle> DataReader::readCSV() {
                 candle.changePercent = std::stod(trim(changeStr));
             }
         } catch (const std::exception& e) {
-            std::cerr << "Conversion error on line: " << rawLine << "\nReason: " << e.what() << std::endl;
+            logger()->warn("Conversion error on line: {} ({})", rawLine, e.what());
             continue;
         }
 
         candles.push_back(candle);
     }
 
-    std::cout << "Loaded " << candles.size() << " candles from CSV.\n";
+    logger()->info("Loaded {} candles from CSV.", candles.size());
     return candles;
 }
 
-// CURL callback
-size_t WriteCallback(void* contents, size_t size, size_t nmemb, void* userp) {
-    ((std::string*)userp)->append((char*)contents, size * nmemb);
-    return size * nmemb;
+namespace {
+
+// Zero-copy counterpart of trim()
+std::string_view trimView(std::string_view str) {
+    size_t start = 0;
+    while (start < str.size() && std::isspace(static_cast<unsigned char>(str[start]))) start++;
+    size_t end = str.size();
+    while (end > start && std::isspace(static_cast<unsigned char>(str[end - 1]))) end--;
+    return str.substr(start, end - start);
 }
 
-// Read candles from Binance API with optional volume
-std::vector<Candle> DataReader::readAPI() {
-    CURL* curl;
-    CURLcode res;
-    std::string readBuffer;
+// Take the next ','-delimited field off the front of `rest`, like std::getline(ss, field, ',')
+std::string_view nextField(std::string_view& rest) {
+    size_t comma = rest.find(',');
+    std::string_view field = rest.substr(0, comma);
+    rest = (comma == std::string_view::npos) ? std::string_view() : rest.substr(comma + 1);
+    return field;
+}
+
+// Parse a field the way std::stod(trim(field)) does; returns false where stod would throw.
+// Hexadecimal floats are not accepted (they never appear in the data files).
+bool parseField(std::string_view field, double& out) {
+    field = trimView(field);
+    const char* first = field.data();
+    const char* last = first + field.size();
+    if (first != last && *first == '+') {
+        ++first;  // strtod accepts a leading '+', from_chars does not
+        if (first != last && *first == '-') return false;
+    }
+    if (first == last) return false;
+
+    auto [ptr, ec] = std::from_chars(first, last, out);
+    return ec == std::errc() && ptr != first;
+}
+
+// Parse one CSV row into `candle`, matching the field rules of readCSV()
+bool parseCSVLine(std::string_view line, Candle& candle) {
+    std::string_view rest = line;
+    std::string_view date = nextField(rest);
+    std::string_view openStr = nextField(rest);
+    std::string_view highStr = nextField(rest);
+    std::string_view lowStr = nextField(rest);
+    std::string_view closeStr = nextField(rest);
+    std::string_view volumeStr = nextField(rest);
+    std::string_view changeStr = nextField(rest);
+    std::string_view percentChangeStr = rest;  // remainder of the line
+
+    if (!Utils::parseTimestamp(date, candle.timestamp)) return false;
+    if (!parseField(openStr, candle.open) || !parseField(highStr, candle.high) ||
+        !parseField(lowStr, candle.low) || !parseField(closeStr, candle.close)) {
+        return false;
+    }
+
+    double volume = 0.0;
+    if (parseField(volumeStr, volume) && parseField(percentChangeStr, candle.changePercent)) {
+        candle.volume = static_cast<int>(volume);
+    } else {
+        // volume not provided, shift fields
+        candle.volume = 0;
+        if (!parseField(changeStr, candle.changePercent)) return false;
+    }
+
+    return true;
+}
+
+// Read up to `length` bytes at `offset` (short at end of file)
+std::string readAt(int fd, uint64_t offset, size_t length) {
+    std::string bytes(length, '\0');
+    size_t done = 0;
+    while (done < length) {
+        ssize_t n = ::pread(fd, &bytes[done], length - done, static_cast<off_t>(offset + done));
+        if (n <= 0) break;
+        done += static_cast<size_t>(n);
+    }
+    bytes.resize(done);
+    return bytes;
+}
+
+} // namespace
+
+// Read candles from a memory-mapped CSV file.
+// Rows are scanned from the end of the mapping towards the header, so candles come out
+// oldest-first without buffering or reversing lines; output is identical to readCSV()
+// and no per-row heap allocation is made.
+std::vector<Candle> DataReader::readCSVMapped() {
     std::vector<Candle> candles;
+    MappedFile file(filepath);
 
-    curl = curl_easy_init();
-    if (curl) {
-        std::string fullUrl = apiEndpoint;
+    if (!file.isOpen()) {
+        logger()->error("Error opening file: {}", filepath);
+        return candles;
+    }
 
-        curl_easy_setopt(curl, CURLOPT_URL, fullUrl.c_str());
-        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &readBuffer);
-        curl_easy_setopt(curl, CURLOPT_USERAGENT, "Mozilla/5.0"); // Binance sometimes requires a User-Agent
+    const char* begin = file.data();
+    const char* end = begin + file.size();
 
-        res = curl_easy_perform(curl);
+    // skip header
+    const char* headerEnd = begin ? static_cast<const char*>(std::memchr(begin, '\n', file.size())) : nullptr;
+    if (!headerEnd) {
+        logger()->info("Loaded 0 candles from CSV.");
+        return candles;
+    }
+    const char* dataBegin = headerEnd + 1;
 
-        if (res != CURLE_OK) {
-            std::cerr << "CURL failed: " << curl_easy_strerror(res) << std::endl;
-            curl_easy_cleanup(curl);
-            return {};
-        }
+    candles.reserve(static_cast<size_t>(std::count(dataBegin, end, '\n')) + 1);
 
-        long httpCode = 0;
-        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &httpCode);
-        curl_easy_cleanup(curl);
+    const char* lineEnd = end;
+    while (lineEnd > dataBegin) {
+        const void* nl = memrchr(dataBegin, '\n', static_cast<size_t>(lineEnd - dataBegin));
+        const char* lineBegin = nl ? static_cast<const char*>(nl) + 1 : dataBegin;
+        std::string_view rawLine(lineBegin, static_cast<size_t>(lineEnd - lineBegin));
+        lineEnd = nl ? static_cast<const char*>(nl) : dataBegin;
 
-        if (httpCode != 200) {
-            std::cerr << "API call failed with HTTP code: " << httpCode << std::endl;
-            return {};
+        if (rawLine.empty()) continue;
+        if (rawLine.find("Date") != std::string_view::npos) continue;
+
+        Candle candle;
+        if (!parseCSVLine(rawLine, candle)) {
+            logger()->warn("Conversion error on line: {} (invalid date or numeric field)", rawLine);
+            continue;
         }
-    } else {
-        std::cerr << "Failed to initialize CURL" << std::endl;
-        return {};
+
+        candles.push_back(std::move(candle));
     }
 
-    // Parse Binance response
-    try {
-        json j = json::parse(readBuffer);
-        for (const auto& entry : j) {
-            if (entry.size() < 6) continue;
+    logger()->info("Loaded {} candles from CSV.", candles.size());
+    return candles;
+}
 
-            Candle candle;
+// Tail-following CSV read.
+// The first call parses the whole file. Later calls parse only the bytes appended since,
+// and keep rows newer than anything already returned. If the file was truncated, replaced
+// (different inode) or rewritten in place (its first or last consumed bytes changed), the
+// whole file is parsed again and `replaced` is set.
+// Only newline-terminated rows are consumed; a row still being written is picked up on
+// the next call. Candles come out oldest-first whichever way the file is ordered.
+std::vector<Candle> DataReader::readCSVTail(bool& replaced) {
+    static constexpr size_t kHeadBytes = 256;
+    static constexpr size_t kEndBytes = 64;
+
+    replaced = false;
+    std::vector<Candle> candles;
 
-            // Convert timestamp to readable date
-            std::time_t ts = entry[0].get<long long>() / 1000;
-            std::stringstream ss;
-            ss << std::put_time(std::gmtime(&ts), "%Y-%m-%d %H:%M:%S");
-            candle.date = ss.str();
+    int fd = ::open(filepath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        logger()->error("Error opening file: {}", filepath);
+        return candles;
+    }
 
-            candle.open = std::stod(entry[1].get<std::string>());
-            candle.high = std::stod(entry[2].get<std::string>());
-            candle.low = std::stod(entry[3].get<std::string>());
-            candle.close = std::stod(entry[4].get<std::string>());
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        logger()->error("Error opening file: {}", filepath);
+        ::close(fd);
+        return candles;
+    }
+    const uint64_t size = static_cast<uint64_t>(st.st_size);
+
+    bool rewritten = tailOffset == 0 || static_cast<uint64_t>(st.st_dev) != tailDevice ||
+                     static_cast<uint64_t>(st.st_ino) != tailInode || size < tailOffset ||
+                     readAt(fd, 0, tailHead.size()) != tailHead ||
+                     readAt(fd, tailOffset - tailEnd.size(), tailEnd.size()) != tailEnd;
+
+    const uint64_t from = rewritten ? 0 : tailOffset;
+    const std::string buffer = readAt(fd, from, static_cast<size_t>(size - from));
+    ::close(fd);
+
+    const size_t lastNewline = buffer.rfind('\n');
+    const size_t complete = (lastNewline == std::string::npos) ? 0 : lastNewline + 1;
+    std::string_view chunk(buffer.data(), complete);
+
+    if (rewritten) {
+        replaced = true;
+        tailOffset = 0;
+        tailLastTimestamp = std::numeric_limits<int64_t>::min();
+        tailDevice = static_cast<uint64_t>(st.st_dev);
+        tailInode = static_cast<uint64_t>(st.st_ino);
+        tailHead.assign(chunk.substr(0, kHeadBytes));
+        tailEnd.clear();
+
+        // skip header
+        size_t headerEnd = chunk.find('\n');
+        if (headerEnd == std::string_view::npos) {
+            logger()->info("Loaded 0 candles from CSV.");
+            return candles;
+        }
+        chunk.remove_prefix(headerEnd + 1);
+    }
 
-            // Optional volume
-            if (entry.size() > 5) {
-                candle.volume = std::stod(entry[5].get<std::string>());
-            } else {
-                candle.volume = 0;
-            }
+    while (!chunk.empty()) {
+        size_t nl = chunk.find('\n');
+        std::string_view rawLine = chunk.substr(0, nl);
+        chunk.remove_prefix(nl + 1);
 
-            candle.changePercent = ((candle.close - candle.open) / candle.open) * 100.0;
+        if (rawLine.empty()) continue;
+        if (rawLine.find("Date") != std::string_view::npos) continue;
 
-            candles.push_back(candle);
+        Candle candle;
+        if (!parseCSVLine(rawLine, candle)) {
+            logger()->warn("Conversion error on line: {} (invalid date or numeric field)", rawLine);
+            continue;
         }
+        if (!rewritten && candle.timestamp <= tailLastTimestamp) continue;
 
-        std::sort(candles.begin(), candles.end(), [](const Candle& a, const Candle& b) {
-            return a.date < b.date;
-        });
+        candles.push_back(std::move(candle));
+    }
 
-    } catch (const std::exception& e) {
-        std::cerr << "Error parsing Binance API response: " << e.what() << std::endl;
-        return {};
+    // Data files list the newest row first; reversing first keeps equal timestamps in readCSV() order
+    if (rewritten) std::reverse(candles.begin(), candles.end());
+    std::stable_sort(candles.begin(), candles.end(), [](const Candle& a, const Candle& b) {
+        return a.timestamp < b.timestamp;
+    });
+
+    tailOffset = from + complete;
+    tailEnd += buffer.substr(complete > kEndBytes ? complete - kEndBytes : 0, std::min(complete, kEndBytes));
+    if (tailEnd.size() > kEndBytes) tailEnd.erase(0, tailEnd.size() - kEndBytes);
+    if (!candles.empty()) tailLastTimestamp = std::max(tailLastTimestamp, candles.back().timestamp);
+
+    logger()->info("Loaded {} {} from CSV.", candles.size(), rewritten ? "candles" : "new candles");
+    return candles;
+}
+
+void DataReader::supplyAPIResponse(std::vector<Candle> candles) {
+    suppliedCandles = std::move(candles);
+    hasSupplied = true;
+}
+
+std::string DataReader::apiRequestUrl() const {
+    return cache ? cache->requestUrl() : apiEndpoint;
+}
+
+// Read candles from Binance API with optional volume. The connection is kept
+// open between calls; a supplied response is used instead when there is one.
+std::vector<Candle> DataReader::fetchAPI() {
+    if (hasSupplied) {
+        hasSupplied = false;
+        return std::move(suppliedCandles);
     }
 
+    if (!fetcher) {
+        fetcher = std::make_unique<KlineFetcher>();
+        fetcher->add(apiEndpoint);
+    }
+    fetcher->setUrl(0, apiRequestUrl());
+
+    std::vector<Candle> candles;
+    if (!fetcher->fetch(0, candles)) {
+        return {};
+    }
     return candles;
 }
 
+// With a cache, the new bars are merged into it and the whole cached series is returned
+// (also when the fetch failed, so a restart without network still has its history)
+std::vector<Candle> DataReader::readAPI() {
+    if (!cache) {
+        return fetchAPI();
+    }
+    cache->merge(fetchAPI());
+    return cache->series().toCandles();
+}
+
 // Wrapper to pick source
 std::vector<Candle> DataReader::readData() {
     if (dataSource == "CSV") {
-        return readCSV();
+        return (csvReader == "mmap") ? readCSVMapped() : readCSV();  // "tail" reads in full here
     } else if (dataSource == "API") {
         return readAPI();
+    } else if (dataSource == "BIN") {
+        return readBinary().toCandles();
     } else {
-        std::cerr << "Invalid data source: " << dataSource << std::endl;
+        logger()->error("Invalid data source: {}", dataSource);
         return {};
     }
 }
+
+std::vector<Candle> DataReader::readNewData(bool& replaced) {
+    if (followsTail()) {
+        return readCSVTail(replaced);
+    }
+    replaced = true;
+    return readData();
+}
+
+// Load a binary candle store
+CandleSeries DataReader::readBinary() {
+    CandleSeries candles;
+    CandleStoreInfo info;
+    if (!CandleStore::read(filepath, candles, &info)) {
+        return CandleSeries();
+    }
+
+    logger()->info("Loaded {} candles from {}.", candles.size(), info.symbol.empty() ? "binary store" : info.symbol);
+    return candles;
+}
+
+CandleSeries DataReader::readSeries() {
+    if (dataSource == "BIN") {
+        return readBinary();
+    }
+    if (dataSource == "API" && cache) {
+        cache->merge(fetchAPI());
+        return cache->series();
+    }
+    return CandleSeries(readData());
+}
+
+bool DataReader::exportBinary(const std::string& path, const std::string& symbol, const std::string& timeframe) {
+    const CandleSeries candles = readSeries();
+    if (candles.empty()) {
+        logger()->error("No candles to export from: {}", dataSource == "API" ? apiEndpoint : filepath);
+        return false;
+    }
+    return CandleStore::write(path, candles, symbol, timeframe);
+}
@@ -0,0 +1,180 @@
+#include "DetectionPipeline.h"
+#include "StructureUtils.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+// ==============================
+// DetectionPipeline
+// ==============================
+
+DetectionPipeline& DetectionPipeline::add(std::unique_ptr<PipelineStage> stage) {
+    stages.push_back(std::move(stage));
+    return *this;
+}
+
+PipelineResult DetectionPipeline::run(const CandleSeries& candles) {
+    PipelineResult result;
+    const size_t n = candles.size();
+
+    for (auto& stage : stages) stage->begin(candles, result);
+
+    for (size_t first = 0; first < n; first += kBlockBars) {
+        const size_t last = std::min(n, first + kBlockBars);
+        for (auto& stage : stages) stage->scan(candles, first, last, result);
+    }
+
+    std::vector<PipelineStage*> resolving;
+    for (auto& stage : stages) {
+        if (stage->beginResolve(candles, result)) resolving.push_back(stage.get());
+    }
+    for (size_t first = 0; first < n && !resolving.empty(); first += kBlockBars) {
+        const size_t last = std::min(n, first + kBlockBars);
+        auto done = [&](PipelineStage* stage) { return !stage->resolve(candles, first, last, result); };
+        resolving.erase(std::remove_if(resolving.begin(), resolving.end(), done), resolving.end());
+    }
+
+    for (auto& stage : stages) stage->finish(candles, result);
+    return result;
+}
+
+DetectionPipeline DetectionPipeline::standard(int swingLookback, double retraceThreshold, double trendlineThreshold,
+                                              size_t trendlinePairSpan, size_t atrPeriod) {
+    DetectionPipeline pipeline;
+    pipeline.add(std::make_unique<SwingStage>(swingLookback))
+        .add(std::make_unique<TrendlineStage>(trendlineThreshold, trendlinePairSpan))
+        .add(std::make_unique<OrderBlockStage>())
+        .add(std::make_unique<BOSStage>())
+        .add(std::make_unique<CHoCHStage>(retraceThreshold))
+        .add(std::make_unique<EntryStage>())
+        .add(std::make_unique<SummaryStage>(atrPeriod));
+    return pipeline;
+}
+
+// ==============================
+// Standard stages
+// ==============================
+
+void SwingStage::begin(const CandleSeries&, PipelineResult&) {
+    detector.reset();
+}
+
+void SwingStage::scan(const CandleSeries& candles, size_t first, size_t last, PipelineResult& result) {
+    StructurePoint swing;
+    for (size_t i = first; i < last; ++i) {
+        if (detector.push(candles.high[i], candles.low[i], candles.timestamp[i], swing)) {
+            result.swingPoints.push_back(swing);
+        }
+    }
+}
+
+void TrendlineStage::begin(const CandleSeries&, PipelineResult&) {
+    detector.reset();
+    nextSwing = 0;
+}
+
+void TrendlineStage::scan(const CandleSeries& candles, size_t, size_t, PipelineResult& result) {
+    for (; nextSwing < result.swingPoints.size(); ++nextSwing) {
+        detector.addSwing(result.swingPoints[nextSwing], candles, result.trendBreaks);
+    }
+}
+
+void TrendlineStage::finish(const CandleSeries&, PipelineResult& result) {
+    // Highs and lows interleave; restore candle order (at most one break per candle)
+    std::sort(result.trendBreaks.begin(), result.trendBreaks.end(),
+              [](const StructurePoint& a, const StructurePoint& b) { return a.index < b.index; });
+}
+
+void OrderBlockStage::scan(const CandleSeries& candles, size_t first, size_t last, PipelineResult& result) {
+    for (size_t j = std::max<size_t>(first, 2); j < last; ++j) {
+        detectOrderBlocksAt(candles, j - 2, result.orderBlocks);
+    }
+}
+
+bool BOSStage::beginResolve(const CandleSeries&, PipelineResult& result) {
+    highs.clear();
+    lows.clear();
+    nextHigh = 0;
+    nextLow = 0;
+
+    // SwingDetector reports at most one swing per bar, so every swing breaks once
+    for (const auto& swing : result.swingPoints) {
+        if (std::isnan(swing.price)) continue;  // never broken
+        if (swing.type == StructureType::SwingHigh) highs.push_back(swing.price);
+        else if (swing.type == StructureType::SwingLow) lows.push_back(swing.price);
+    }
+    std::sort(highs.begin(), highs.end());
+    std::sort(lows.begin(), lows.end(), std::greater<double>());
+    return !highs.empty() || !lows.empty();
+}
+
+bool BOSStage::resolve(const CandleSeries& candles, size_t first, size_t last, PipelineResult& result) {
+    for (size_t i = std::max<size_t>(first, 1); i < last && (nextHigh < highs.size() || nextLow < lows.size()); ++i) {
+        const double close = candles.close[i];
+        size_t broken = 0;
+        for (; nextHigh < highs.size() && highs[nextHigh] < close; ++nextHigh) ++broken;
+        for (; nextLow < lows.size() && lows[nextLow] > close; ++nextLow) ++broken;
+
+        if (broken > 0) {
+            result.bosPoints.insert(result.bosPoints.end(), broken,
+                                    StructurePoint{candles.timestamp[i], close, StructureType::BOS, i});
+        }
+    }
+    return nextHigh < highs.size() || nextLow < lows.size();
+}
+
+bool CHoCHStage::beginResolve(const CandleSeries&, PipelineResult& result) {
+    detector.reset();
+    nextSwing = 0;
+    return !result.swingPoints.empty();
+}
+
+bool CHoCHStage::resolve(const CandleSeries& candles, size_t first, size_t last, PipelineResult& result) {
+    // SwingStage reports swings in index order
+    const std::vector<StructurePoint>& swings = result.swingPoints;
+    StructurePoint point;
+    for (size_t i = std::max<size_t>(first, 1); i < last; ++i) {
+        for (; nextSwing < swings.size() && swings[nextSwing].index < i; ++nextSwing) detector.addSwing(swings[nextSwing]);
+        if (detector.push(i, candles.close[i], candles.timestamp[i], point)) {
+            result.chochPoints.push_back(point);
+        }
+    }
+    return true;
+}
+
+bool EntryStage::beginResolve(const CandleSeries&, PipelineResult& result) {
+    if (result.orderBlocks.empty()) return false;
+
+    const OBZone& zone = result.orderBlocks.back().first;
+    formedAt = zone.timestamp;
+    zoneLow = std::min(zone.bottom, zone.top);
+    zoneHigh = std::max(zone.bottom, zone.top);
+    return true;
+}
+
+bool EntryStage::resolve(const CandleSeries& candles, size_t first, size_t last, PipelineResult& result) {
+    for (size_t i = first; i < last; ++i) {
+        if (candles.timestamp[i] > formedAt && candles.close[i] >= zoneLow && candles.close[i] <= zoneHigh) {
+            result.entryFound = true;
+            result.entryPrice = candles.close[i];
+            return false;
+        }
+    }
+    return true;
+}
+
+void SummaryStage::begin(const CandleSeries&, PipelineResult&) {
+    tracker.reset();
+}
+
+void SummaryStage::scan(const CandleSeries& candles, size_t first, size_t last, PipelineResult&) {
+    for (size_t i = first; i < last; ++i) {
+        tracker.push(candles.high[i], candles.low[i], candles.close[i]);
+    }
+}
+
+void SummaryStage::finish(const CandleSeries& candles, PipelineResult& result) {
+    result.structureEvents = StructureUtils::gatherStructureEvents(result.bosPoints, result.chochPoints,
+                                                                   result.trendBreaks, candles);
+    result.atr = tracker.value();
+}
@@ -0,0 +1,115 @@
+#include "IncrementalStructure.h"
+#include <algorithm>
+#include <cmath>
+
+IncrementalStructure::IncrementalStructure(int swingLookback, double retraceThreshold,
+                                           double trendlineThreshold, size_t trendlinePairSpan)
+    : swingLookback(swingLookback),
+      retraceThreshold(retraceThreshold),
+      trendlineThreshold(trendlineThreshold),
+      trendlinePairSpan(trendlinePairSpan),
+      swingDetector(swingLookback),
+      trendlineDetector(trendlineThreshold, trendlinePairSpan),
+      choch(retraceThreshold) {}
+
+void IncrementalStructure::reset() {
+    *this = IncrementalStructure(swingLookback, retraceThreshold, trendlineThreshold, trendlinePairSpan);
+}
+
+std::vector<StructurePoint> IncrementalStructure::sortByIndex(std::vector<StructurePoint> points) {
+    std::stable_sort(points.begin(), points.end(),
+                     [](const StructurePoint& a, const StructurePoint& b) { return a.index < b.index; });
+    return points;
+}
+
+void IncrementalStructure::append(const Candle& candle) {
+    const size_t j = candles.size();
+    candles.push_back(candle);
+    const double close = candle.close;
+
+    // Last cycle's provisional CHoCH points were appended last; take them back
+    for (; provisionalCHoCH > 0; --provisionalCHoCH) {
+        chochPoints.pop_back();
+        structureEvents.pop_back();
+    }
+
+    // The batch BOS / CHoCH loops start at bar 1
+    closeExtremes.push(close);
+    if (j > 0) {
+        size_t broken = 0;
+        for (; !activeHighs.empty() && activeHighs.top() < close; activeHighs.pop()) ++broken;
+        for (; !activeLows.empty() && activeLows.top() > close; activeLows.pop()) ++broken;
+        addBOS(j, broken);
+    }
+
+    StructurePoint swing;
+    if (swingDetector.push(candle.high, candle.low, candle.timestamp, swing)) {
+        onSwing(swing);
+    }
+
+    if (j >= 2) {
+        detectOrderBlocksAt(candles, j - 2, orderBlocks);
+    }
+
+    updateCHoCH();
+}
+
+void IncrementalStructure::updateCHoCH() {
+    // Swings through bar n - lookback are known, so bars through n - lookback + 1 are final
+    const size_t n = candles.size();
+    const size_t lag = swingLookback > 0 ? static_cast<size_t>(swingLookback) - 1 : 0;
+    const size_t finalEnd = n > lag ? n - lag : 0;
+
+    StructurePoint point;
+    for (; nextCHoCHBar < finalEnd; ++nextCHoCHBar) {
+        for (; nextCHoCHSwing < swingPoints.size() && swingPoints[nextCHoCHSwing].index < nextCHoCHBar; ++nextCHoCHSwing) {
+            choch.addSwing(swingPoints[nextCHoCHSwing]);
+        }
+        if (choch.push(nextCHoCHBar, candles.close[nextCHoCHBar], candles.timestamp[nextCHoCHBar], point)) addCHoCH(point);
+    }
+
+    // The rest as the batch detector sees it now (no swing before them is pending)
+    CHoCHDetector tail = choch;
+    for (size_t i = std::max<size_t>(nextCHoCHBar, 1); i < n; ++i) {
+        if (tail.push(i, candles.close[i], candles.timestamp[i], point)) {
+            addCHoCH(point);
+            ++provisionalCHoCH;
+        }
+    }
+}
+
+void IncrementalStructure::onSwing(const StructurePoint& swing) {
+    swingPoints.push_back(swing);
+
+    // First close from bar 1 on beyond the swing (as bosKnownBars), else wait for one
+    const size_t broken = closeExtremes.firstBreak(swing);
+    if (broken < closeExtremes.size()) {
+        addBOS(broken, 1);
+    } else if (!std::isnan(swing.price)) {
+        if (swing.type == StructureType::SwingHigh) activeHighs.push(swing.price);
+        else if (swing.type == StructureType::SwingLow) activeLows.push(swing.price);
+    }
+
+    const size_t first = trendBreaks.size();
+    trendlineDetector.addSwing(swing, candles, trendBreaks);
+    for (size_t k = first; k < trendBreaks.size(); ++k) {
+        structureEvents.emplace_back(StructureEventType::TrendlineBreak, trendBreaks[k].timestamp, trendBreaks[k].price);
+    }
+}
+
+void IncrementalStructure::addBOS(size_t index, size_t count) {
+    if (count == 0) return;
+
+    const StructurePoint point{candles.timestamp[index], candles.close[index], StructureType::BOS, index};
+    const StructureEventType type = candles.isBullish(index) ? StructureEventType::BOS_Bullish : StructureEventType::BOS_Bearish;
+    for (size_t n = 0; n < count; ++n) {
+        bosPoints.push_back(point);
+        structureEvents.emplace_back(type, point.timestamp, point.price);
+    }
+}
+
+void IncrementalStructure::addCHoCH(const StructurePoint& point) {
+    chochPoints.push_back(point);
+    structureEvents.emplace_back(candles.isBullish(point.index) ? StructureEventType::CHoCH_Bullish : StructureEventType::CHoCH_Bearish,
+                                 point.timestamp, point.price);
+}
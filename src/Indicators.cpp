@@ -0,0 +1,106 @@
+#include "Indicators.h"
+#include <algorithm>
+#include <cmath>
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace Indicators {
+
+void trueRange(const double* high, const double* low, const double* prevClose, double* out, size_t count) {
+    size_t i = 0;
+
+    // |x| clears the sign bit; the three ranges are non-NaN for real bars, so max
+    // picks the same value std::max does
+#if defined(__AVX__)
+    const __m256d signMask4 = _mm256_set1_pd(-0.0);
+    for (; i + 4 <= count; i += 4) {
+        const __m256d h = _mm256_loadu_pd(high + i);
+        const __m256d l = _mm256_loadu_pd(low + i);
+        const __m256d c = _mm256_loadu_pd(prevClose + i);
+        const __m256d upMove = _mm256_andnot_pd(signMask4, _mm256_sub_pd(h, c));
+        const __m256d downMove = _mm256_andnot_pd(signMask4, _mm256_sub_pd(l, c));
+        _mm256_storeu_pd(out + i, _mm256_max_pd(_mm256_max_pd(_mm256_sub_pd(h, l), upMove), downMove));
+    }
+#endif
+#if defined(__SSE2__)
+    const __m128d signMask2 = _mm_set1_pd(-0.0);
+    for (; i + 2 <= count; i += 2) {
+        const __m128d h = _mm_loadu_pd(high + i);
+        const __m128d l = _mm_loadu_pd(low + i);
+        const __m128d c = _mm_loadu_pd(prevClose + i);
+        const __m128d upMove = _mm_andnot_pd(signMask2, _mm_sub_pd(h, c));
+        const __m128d downMove = _mm_andnot_pd(signMask2, _mm_sub_pd(l, c));
+        _mm_storeu_pd(out + i, _mm_max_pd(_mm_max_pd(_mm_sub_pd(h, l), upMove), downMove));
+    }
+#endif
+    for (; i < count; ++i) {
+        out[i] = std::max({high[i] - low[i], std::fabs(high[i] - prevClose[i]), std::fabs(low[i] - prevClose[i])});
+    }
+}
+
+std::vector<double> trueRange(const CandleSeries& candles) {
+    const size_t n = candles.size();
+    std::vector<double> out(n);
+    if (n == 0) return out;
+
+    out[0] = candles.high[0] - candles.low[0];
+    trueRange(candles.high.data() + 1, candles.low.data() + 1, candles.close.data(), out.data() + 1, n - 1);
+    return out;
+}
+
+std::vector<double> atrSeries(const CandleSeries& candles, size_t period, ATRMethod method) {
+    std::vector<double> ranges = trueRange(candles);
+
+    // The tracker's arithmetic, so the series and a live feed agree to the bit
+    ATRTracker tracker(period, method);
+    if (!ranges.empty()) ranges[0] = 0.0;
+    for (size_t i = 1; i < ranges.size(); ++i) {
+        ranges[i] = tracker.addTrueRange(ranges[i]);
+    }
+    return ranges;
+}
+
+ATRTracker::ATRTracker(size_t period, ATRMethod method) : method(method), window(period, 0.0) {}
+
+double ATRTracker::push(double high, double low, double close) {
+    const bool first = !started;
+    const double previous = prevClose;
+    started = true;
+    prevClose = close;
+    if (first) return atr;  // no previous close, no true range
+
+    double range;
+    trueRange(&high, &low, &previous, &range, 1);
+    return addTrueRange(range);
+}
+
+double ATRTracker::addTrueRange(double trueRange) {
+    const size_t period = window.size();
+    if (period == 0) return atr;
+
+    // Running window sum; re-added in bar order whenever the window wraps, so rounding
+    // cannot build up and every period-th value equals calculateATR's sum exactly
+    ++ranges;
+    sum += trueRange - (ranges > period ? window[next] : 0.0);
+    window[next] = trueRange;
+    next = next + 1 == period ? 0 : next + 1;
+    if (next == 0) {
+        sum = 0.0;
+        for (double range : window) sum += range;
+    }
+
+    if (ranges < period) return atr;
+    if (ranges == period || method == ATRMethod::Simple) {
+        atr = sum / static_cast<double>(period);
+    } else {
+        atr = (atr * static_cast<double>(period - 1) + trueRange) / static_cast<double>(period);
+    }
+    return atr;
+}
+
+void ATRTracker::reset() {
+    *this = ATRTracker(window.size(), method);
+}
+
+} // namespace Indicators
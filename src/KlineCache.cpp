@@ -0,0 +1,141 @@
+#include "KlineCache.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <sys/stat.h>
+#include <spdlog/spdlog.h>
+#include "CandleStore.h"
+
+namespace {
+
+// Value of `name` in the endpoint's query string ("" when absent)
+std::string queryParam(const std::string& url, const std::string& name) {
+    const size_t query = url.find('?');
+    if (query == std::string::npos) return "";
+
+    size_t pos = query + 1;
+    while (pos < url.size()) {
+        size_t end = url.find('&', pos);
+        if (end == std::string::npos) end = url.size();
+        const size_t eq = url.find('=', pos);
+        if (eq != std::string::npos && eq < end && url.compare(pos, eq - pos, name) == 0) {
+            return url.substr(eq + 1, end - eq - 1);
+        }
+        pos = end + 1;
+    }
+    return "";
+}
+
+// Bars per response: Binance's default and cap for `limit`
+constexpr size_t kDefaultPage = 500;
+constexpr size_t kMaxPage = 1000;
+
+size_t pageLimit(const std::string& endpoint) {
+    const std::string limit = queryParam(endpoint, "limit");
+    const long value = limit.empty() ? 0 : std::strtol(limit.c_str(), nullptr, 10);
+    if (value <= 0) return kDefaultPage;
+    return std::min(static_cast<size_t>(value), kMaxPage);
+}
+
+// Seconds per bar of a Binance interval ("15m", "4h", "1d", ...); 0 when unknown.
+// Months count as 28 days, so a gap is never under-estimated.
+int64_t intervalLength(const std::string& interval) {
+    if (interval.size() < 2) return 0;
+    char* end = nullptr;
+    const long count = std::strtol(interval.c_str(), &end, 10);
+    if (count <= 0 || end != interval.c_str() + interval.size() - 1) return 0;
+
+    int64_t unit = 0;
+    switch (interval.back()) {
+        case 'm': unit = 60; break;
+        case 'h': unit = 3600; break;
+        case 'd': unit = 86400; break;
+        case 'w': unit = 7 * 86400; break;
+        case 'M': unit = 28 * 86400; break;
+        default: return 0;
+    }
+    return count * unit;
+}
+
+// Keep file names to [A-Za-z0-9_-]
+std::string fileSafe(const std::string& text) {
+    std::string out = text;
+    for (char& c : out) {
+        if (!std::isalnum(static_cast<unsigned char>(c)) && c != '-') c = '_';
+    }
+    return out;
+}
+
+bool fileExists(const std::string& path) {
+    struct stat st;
+    return ::stat(path.c_str(), &st) == 0 && S_ISREG(st.st_mode);
+}
+
+} // namespace
+
+KlineCache::KlineCache(const std::string& dir, const std::string& endpoint)
+    : endpoint(endpoint), symbol(queryParam(endpoint, "symbol")), interval(queryParam(endpoint, "interval")),
+      page(pageLimit(endpoint)), intervalSeconds(intervalLength(interval)) {
+    // Endpoints without a symbol fall back to a name derived from the whole URL
+    std::string name = fileSafe(symbol) + "_" + fileSafe(interval);
+    if (symbol.empty()) {
+        char hash[17];
+        std::snprintf(hash, sizeof(hash), "%016zx", std::hash<std::string>()(endpoint));
+        name = std::string("klines_") + hash;
+    }
+    file = dir + "/" + name + ".bin";
+
+    if (::mkdir(dir.c_str(), 0755) != 0 && errno != EEXIST) {
+        spdlog::error("Cannot create kline cache directory {}: {}", dir, std::strerror(errno));
+    }
+
+    if (fileExists(file) && !CandleStore::read(file, cached)) {
+        cached.clear();  // unreadable: start over from the endpoint
+    }
+    if (cached.size() > page) cached.dropFront(cached.size() - page);  // limit lowered since
+}
+
+bool KlineCache::supports(const std::string& endpoint) {
+    return queryParam(endpoint, "startTime").empty() && queryParam(endpoint, "endTime").empty();
+}
+
+std::string KlineCache::requestUrl() const {
+    if (cached.empty() || behind) return endpoint;
+
+    // Bars from the last cached one up to now; more than a page cannot be caught up in one request
+    const int64_t lastOpen = cached.timestamp.back();
+    if (intervalSeconds > 0) {
+        const int64_t now = static_cast<int64_t>(std::time(nullptr));
+        if (now > lastOpen && (now - lastOpen) / intervalSeconds + 1 > static_cast<int64_t>(page)) return endpoint;
+    }
+
+    const int64_t lastOpenMs = lastOpen * 1000;
+    return endpoint + (endpoint.find('?') == std::string::npos ? "?" : "&") + "startTime=" + std::to_string(lastOpenMs);
+}
+
+void KlineCache::merge(const std::vector<Candle>& fetched) {
+    if (fetched.empty()) return;
+
+    // Responses are in time order; everything cached from their first bar on is superseded.
+    // A response starting after the last cached bar may leave a gap, so it replaces the cache.
+    const int64_t first = fetched.front().timestamp;
+    const bool overlaps = !cached.empty() && first <= cached.timestamp.back();
+    const auto keep = std::lower_bound(cached.timestamp.begin(), cached.timestamp.end(), first);
+    cached.truncate(overlaps ? static_cast<size_t>(keep - cached.timestamp.begin()) : 0);
+    cached.reserve(cached.size() + fetched.size());
+    for (const auto& candle : fetched) {
+        cached.push_back(candle);
+    }
+
+    // A full page from startTime on may stop short of the latest bar: request the
+    // endpoint as is next time
+    behind = overlaps && fetched.size() >= page;
+    if (cached.size() > page) cached.dropFront(cached.size() - page);
+
+    CandleStore::write(file, cached, symbol, interval);
+}
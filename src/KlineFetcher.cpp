@@ -0,0 +1,146 @@
+#include "KlineFetcher.h"
+#include <curl/curl.h>
+#include <mutex>
+#include <spdlog/spdlog.h>
+#include "KlineParser.h"
+
+namespace {
+
+size_t appendBody(void* contents, size_t size, size_t nmemb, void* userp) {
+    static_cast<std::string*>(userp)->append(static_cast<char*>(contents), size * nmemb);
+    return size * nmemb;
+}
+
+// curl_global_init is not thread-safe; every fetcher goes through here first
+void initCurlOnce() {
+    static std::once_flag once;
+    std::call_once(once, [] { curl_global_init(CURL_GLOBAL_DEFAULT); });
+}
+
+} // namespace
+
+struct KlineFetcher::Source {
+    CURL* easy = nullptr;
+    std::string url;
+    std::string body;
+    char error[CURL_ERROR_SIZE] = {};
+};
+
+KlineFetcher::KlineFetcher(long timeoutMs) : timeoutMs(timeoutMs) {
+    initCurlOnce();
+    multi = curl_multi_init();
+    curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+}
+
+KlineFetcher::~KlineFetcher() {
+    for (auto& source : sources) {
+        curl_easy_cleanup(source->easy);
+    }
+    curl_multi_cleanup(multi);
+}
+
+size_t KlineFetcher::add(const std::string& url) {
+    auto source = std::make_unique<Source>();
+    source->easy = curl_easy_init();
+    source->url = url;
+
+    CURL* easy = source->easy;
+    curl_easy_setopt(easy, CURLOPT_URL, source->url.c_str());
+    curl_easy_setopt(easy, CURLOPT_WRITEFUNCTION, appendBody);
+    curl_easy_setopt(easy, CURLOPT_WRITEDATA, &source->body);
+    curl_easy_setopt(easy, CURLOPT_ERRORBUFFER, source->error);
+    curl_easy_setopt(easy, CURLOPT_USERAGENT, "Mozilla/5.0"); // Binance sometimes requires a User-Agent
+    curl_easy_setopt(easy, CURLOPT_ACCEPT_ENCODING, "");      // any compression curl supports
+    curl_easy_setopt(easy, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(easy, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(easy, CURLOPT_TIMEOUT_MS, timeoutMs);
+    curl_easy_setopt(easy, CURLOPT_PIPEWAIT, 1L);             // wait to multiplex rather than open another connection
+
+    sources.push_back(std::move(source));
+    return sources.size() - 1;
+}
+
+void KlineFetcher::setUrl(size_t source, const std::string& url) {
+    Source& s = *sources.at(source);
+    s.url = url;
+    curl_easy_setopt(s.easy, CURLOPT_URL, s.url.c_str());
+}
+
+const std::string& KlineFetcher::url(size_t source) const {
+    return sources.at(source)->url;
+}
+
+void KlineFetcher::fetchAll(const Callback& onDone) {
+    std::vector<size_t> ids(sources.size());
+    for (size_t i = 0; i < ids.size(); ++i) ids[i] = i;
+    run(ids, onDone);
+}
+
+bool KlineFetcher::fetch(size_t source, std::vector<Candle>& out) {
+    bool result = false;
+    run({source}, [&](size_t, std::vector<Candle>&& candles, bool ok) {
+        out = std::move(candles);
+        result = ok;
+    });
+    return result;
+}
+
+void KlineFetcher::run(const std::vector<size_t>& ids, const Callback& onDone) {
+    std::vector<bool> attached(sources.size(), false);
+    for (size_t id : ids) {
+        Source& source = *sources.at(id);
+        source.body.clear();
+        source.error[0] = '\0';
+        curl_easy_setopt(source.easy, CURLOPT_PRIVATE, reinterpret_cast<char*>(id));
+        attached[id] = curl_multi_add_handle(multi, source.easy) == CURLM_OK;
+        if (!attached[id]) onDone(id, {}, false);
+    }
+
+    int running = 0;
+    do {
+        CURLMcode mc = curl_multi_perform(multi, &running);
+        if (mc == CURLM_OK && running > 0) {
+            mc = curl_multi_poll(multi, nullptr, 0, 1000, nullptr);
+        }
+        if (mc != CURLM_OK) {
+            spdlog::error("CURL multi failed: {}", curl_multi_strerror(mc));
+            break;
+        }
+
+        // Completed transfers, as they finish
+        int queued = 0;
+        while (CURLMsg* msg = curl_multi_info_read(multi, &queued)) {
+            if (msg->msg != CURLMSG_DONE) continue;
+
+            CURL* easy = msg->easy_handle;
+            const CURLcode res = msg->data.result;
+            char* idPtr = nullptr;
+            curl_easy_getinfo(easy, CURLINFO_PRIVATE, &idPtr);
+            const size_t id = reinterpret_cast<size_t>(idPtr);
+            Source& source = *sources[id];
+
+            long httpCode = 0;
+            curl_easy_getinfo(easy, CURLINFO_RESPONSE_CODE, &httpCode);
+            curl_multi_remove_handle(multi, easy);
+            attached[id] = false;
+
+            std::vector<Candle> candles;
+            bool ok = false;
+            if (res != CURLE_OK) {
+                spdlog::error("CURL failed: {} ({})", source.error[0] ? source.error : curl_easy_strerror(res), source.url);
+            } else if (httpCode != 200) {
+                spdlog::error("API call failed with HTTP code: {} ({})", httpCode, source.url);
+            } else {
+                ok = KlineParser::parse(source.body, candles);
+            }
+            onDone(id, std::move(candles), ok);
+        }
+    } while (running > 0);
+
+    // Transfers still attached here were cut short by a multi handle failure
+    for (size_t id : ids) {
+        if (!attached[id]) continue;
+        curl_multi_remove_handle(multi, sources[id]->easy);
+        onDone(id, {}, false);
+    }
+}
@@ -0,0 +1,254 @@
+#include "KlineParser.h"
+#include <algorithm>
+#include <charconv>
+#include <stdexcept>
+#include <spdlog/spdlog.h>
+
+// Single pass over the response: no DOM, no temporary strings. Numeric strings are
+// converted where they sit in the body and candles are written straight into `out`.
+// Follows the nlohmann::json path it replaced: entries with fewer than 6 elements
+// are skipped, anything else that is not [int, "num" x5, ...] fails the whole body.
+
+namespace {
+
+struct Malformed : std::runtime_error {
+    Malformed(const char* what, const char* at, const char* begin)
+        : std::runtime_error(std::string(what) + " at byte " + std::to_string(at - begin)) {}
+};
+
+class Reader {
+public:
+    Reader(const char* begin, const char* end) : begin(begin), p(begin), end(end) {}
+
+    void skipSpace() {
+        while (p != end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t')) ++p;
+    }
+
+    // Next non-space character without consuming it ('\0' at the end)
+    char peek() {
+        skipSpace();
+        return p != end ? *p : '\0';
+    }
+
+    void expect(char c, const char* what) {
+        if (peek() != c) fail(what);
+        ++p;
+    }
+
+    // After a value inside [...]: true if another element follows
+    bool nextElement() {
+        const char c = peek();
+        ++p;
+        if (c == ',') return true;
+        if (c == ']') return false;
+        fail("expected ',' or ']'");
+    }
+
+    bool atEnd() {
+        skipSpace();
+        return p == end;
+    }
+
+    // String contents; unescaped text is returned in place, escaped text is decoded into `scratch`
+    std::string_view string(std::string& scratch) {
+        expect('"', "expected a string");
+        const char* first = p;
+        while (p != end && *p != '"' && *p != '\\') {
+            if (static_cast<unsigned char>(*p) < 0x20) fail("control character in string");
+            ++p;
+        }
+        if (p == end) fail("unterminated string");
+        if (*p == '"') return std::string_view(first, static_cast<size_t>(p++ - first));
+
+        scratch.assign(first, p);
+        while (p != end && *p != '"') {
+            if (static_cast<unsigned char>(*p) < 0x20) fail("control character in string");
+            if (*p != '\\') {
+                scratch.push_back(*p++);
+                continue;
+            }
+            if (++p == end) break;
+            switch (*p++) {
+                case '"': scratch.push_back('"'); break;
+                case '\\': scratch.push_back('\\'); break;
+                case '/': scratch.push_back('/'); break;
+                case 'b': scratch.push_back('\b'); break;
+                case 'f': scratch.push_back('\f'); break;
+                case 'n': scratch.push_back('\n'); break;
+                case 'r': scratch.push_back('\r'); break;
+                case 't': scratch.push_back('\t'); break;
+                case 'u': {
+                    unsigned code = 0;
+                    if (end - p < 4 || std::from_chars(p, p + 4, code, 16).ptr != p + 4) fail("bad \\u escape");
+                    p += 4;
+                    scratch.push_back(code < 0x80 ? static_cast<char>(code) : '?');  // only ASCII matters to a number
+                    break;
+                }
+                default: fail("bad escape");
+            }
+        }
+        if (p == end) fail("unterminated string");
+        ++p;
+        return scratch;
+    }
+
+    // Raw text of a number token
+    std::string_view number() {
+        skipSpace();
+        const char* first = p;
+        while (p != end && ((*p >= '0' && *p <= '9') || *p == '-' || *p == '+' || *p == '.' || *p == 'e' || *p == 'E')) ++p;
+        double check;
+        if (p == first || std::from_chars(first, p, check).ptr != p) fail("bad number");
+        return std::string_view(first, static_cast<size_t>(p - first));
+    }
+
+    // Skip any JSON value
+    void skipValue(int depth = 0) {
+        if (depth > 64) fail("nesting too deep");
+        std::string scratch;
+        switch (peek()) {
+            case '"': string(scratch); return;
+            case '[':
+                ++p;
+                if (peek() == ']') { ++p; return; }
+                do skipValue(depth + 1); while (nextElement());
+                return;
+            case '{':
+                ++p;
+                if (peek() == '}') { ++p; return; }
+                for (;;) {
+                    string(scratch);
+                    expect(':', "expected ':'");
+                    skipValue(depth + 1);
+                    const char c = peek();
+                    ++p;
+                    if (c == '}') return;
+                    if (c != ',') fail("expected ',' or '}'");
+                }
+            case 't': literal("true"); return;
+            case 'f': literal("false"); return;
+            case 'n': literal("null"); return;
+            default: number(); return;
+        }
+    }
+
+    [[noreturn]] void fail(const char* what) const { throw Malformed(what, p, begin); }
+
+private:
+    const char* begin;
+    const char* p;
+    const char* end;
+
+    void literal(const char* word) {
+        for (const char* w = word; *w; ++w, ++p) {
+            if (p == end || *p != *w) fail("bad literal");
+        }
+    }
+};
+
+// std::stod semantics on a field: leading space and '+' allowed, trailing text ignored
+bool toDouble(std::string_view text, double& out) {
+    const char* first = text.data();
+    const char* last = first + text.size();
+    while (first != last && (*first == ' ' || (*first >= '\t' && *first <= '\r'))) ++first;
+    if (first != last && *first == '+') {
+        ++first;
+        if (first != last && *first == '-') return false;
+    }
+    return first != last && std::from_chars(first, last, out).ptr != first;
+}
+
+// An open time as get<long long>() reads it: integers as they are, other numbers truncated
+int64_t toMillis(std::string_view text) {
+    long long ms = 0;
+    const char* last = text.data() + text.size();
+    auto [ptr, ec] = std::from_chars(text.data(), last, ms);
+    if (ec == std::errc() && ptr == last) return ms;
+
+    double value = 0.0;
+    std::from_chars(text.data(), last, value);
+    return static_cast<int64_t>(value);
+}
+
+} // namespace
+
+bool KlineParser::parse(const std::string& body, std::vector<Candle>& out) {
+    out.clear();
+    // Every entry opens a bracket, so this bounds the count from above in one cheap scan
+    out.reserve(static_cast<size_t>(std::count(body.begin(), body.end(), '[')));
+
+    try {
+        Reader in(body.data(), body.data() + body.size());
+        std::string scratch;
+        bool ordered = true;
+
+        in.expect('[', "expected a kline array");
+        if (in.peek() == ']') {
+            in.expect(']', "");
+        } else {
+            do {
+                if (in.peek() != '[') {
+                    in.skipValue();  // not a kline
+                    continue;
+                }
+                in.expect('[', "");
+
+                // Fields are converted as they are read; whether a failed one matters
+                // is only known once the entry turns out to have 6+ elements
+                Candle candle;
+                double fields[5] = {};
+                size_t count = 0;
+                bool valid = true;
+                if (in.peek() == ']') {
+                    in.expect(']', "");
+                } else {
+                    do {
+                        if (count == 0 && in.peek() != '"' && in.peek() != '[' && in.peek() != '{') {
+                            const char c = in.peek();
+                            if (c == 't' || c == 'f' || c == 'n') {
+                                in.skipValue();
+                                valid = false;
+                            } else {
+                                candle.timestamp = toMillis(in.number()) / 1000;  // open time is in milliseconds
+                            }
+                        } else if (count >= 1 && count <= 5 && in.peek() == '"') {
+                            valid = toDouble(in.string(scratch), fields[count - 1]) && valid;
+                        } else {
+                            valid = valid && count > 5;
+                            in.skipValue();
+                        }
+                        ++count;
+                    } while (in.nextElement());
+                }
+
+                if (count < 6) continue;
+                if (!valid) in.fail("kline entry is not [time, \"open\", \"high\", \"low\", \"close\", \"volume\", ...]");
+
+                candle.open = fields[0];
+                candle.high = fields[1];
+                candle.low = fields[2];
+                candle.close = fields[3];
+                candle.volume = static_cast<int>(fields[4]);
+                candle.changePercent = ((candle.close - candle.open) / candle.open) * 100.0;
+
+                // (equal times also go through the sort, which may reorder them as the DOM path did)
+                if (!out.empty() && candle.timestamp <= out.back().timestamp) ordered = false;
+                out.push_back(candle);
+            } while (in.nextElement());
+        }
+        if (!in.atEnd()) in.fail("trailing characters");
+
+        // Binance returns klines oldest first; only sort when that does not hold
+        if (!ordered) {
+            std::sort(out.begin(), out.end(), [](const Candle& a, const Candle& b) {
+                return a.timestamp < b.timestamp;
+            });
+        }
+    } catch (const std::exception& e) {
+        spdlog::error("Error parsing Binance API response: {}", e.what());
+        out.clear();
+        return false;
+    }
+
+    return true;
+}
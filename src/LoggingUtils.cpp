@@ -3,27 +3,37 @@
 #include "TradingUtils.h"
 
 void LoggingUtils::logOrderBlockInfo(const OrderBlock &obBlock, const OBZone &obZone, const std::string &obType,
-                                     const std::string &latestDate, bool foundEntry, double entryPrice,
-                                     const std::vector<Candle> &candles)
+                                     int64_t detectedAt, bool foundEntry, double entryPrice,
+                                     const CandleSeries &candles, spdlog::logger *log)
 {
-    spdlog::info("\n===  {} Order Block ===", obType);
-    spdlog::info("| Date Detected        | {} |", latestDate);
-    spdlog::info("| OB Zone              | Top: {:.2f} | Bottom: {:.2f} |", obZone.top, obZone.bottom);
-    spdlog::info("| Entry Price          | {} | Close: {:.2f} |", foundEntry ? "Candle Close" : "Boundary", entryPrice);
-    spdlog::info("| Strength             | {} |", obBlock.getStrengthString());
-    spdlog::info("| Score                | {:.2f} |", obBlock.score);
+    if (!log)
+        log = spdlog::default_logger_raw();
+
+    log->info("\n===  {} Order Block ===", obType);
+    log->info("| Date Detected        | {} |", Utils::formatTimestamp(detectedAt));
+    log->info("| OB Zone              | Top: {:.2f} | Bottom: {:.2f} |", obZone.top, obZone.bottom);
+    log->info("| Entry Price          | {} | Close: {:.2f} |", foundEntry ? "Candle Close" : "Boundary", entryPrice);
+    log->info("| Strength             | {} |", obBlock.getStrengthString());
+    log->info("| Score                | {:.2f} |", obBlock.score);
 
     std::string trendDirection = TradingUtils::getTrendDirection(candles);
-    spdlog::info("| Trend Direction      | {} |", trendDirection);
+    log->info("| Trend Direction      | {} |", trendDirection);
 
-    spdlog::info("| Recent Candles (last 5) |");
+    log->info("| Recent Candles (last 5) |");
 
     const int n = static_cast<int>(candles.size());
     const int start = std::max(0, n - 5);
     for (int i = start; i < n; ++i)
     {
-        const Candle &curr = candles[i];
-        const Candle *prev = (i > 0) ? &candles[i - 1] : nullptr;
-        TradingUtils::logCandleWithDelta(curr, prev);
+        const Candle curr = candles.at(i);
+        if (i > 0)
+        {
+            const Candle prev = candles.at(i - 1);
+            TradingUtils::logCandleWithDelta(curr, &prev, log);
+        }
+        else
+        {
+            TradingUtils::logCandleWithDelta(curr, nullptr, log);
+        }
     }
 }
\ No newline at end of file
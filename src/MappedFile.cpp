@@ -0,0 +1,65 @@
+#include "MappedFile.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <spdlog/spdlog.h>
+#include <utility>
+
+MappedFile::MappedFile(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        return;
+    }
+
+    length = static_cast<size_t>(st.st_size);
+    if (length > 0) {
+        void* mapped = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) {
+            spdlog::error("mmap failed for file: {}", path);
+            ::close(fd);
+            length = 0;
+            return;
+        }
+        // The readers walk the mapping front-to-back or back-to-front in one go
+        ::madvise(mapped, length, MADV_WILLNEED);
+        ptr = static_cast<const char*>(mapped);
+    }
+
+    ::close(fd);  // the mapping stays valid after the descriptor is closed
+    opened = true;
+}
+
+MappedFile::~MappedFile() {
+    release();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : ptr(std::exchange(other.ptr, nullptr)),
+      length(std::exchange(other.length, 0)),
+      opened(std::exchange(other.opened, false)) {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        release();
+        ptr = std::exchange(other.ptr, nullptr);
+        length = std::exchange(other.length, 0);
+        opened = std::exchange(other.opened, false);
+    }
+    return *this;
+}
+
+void MappedFile::release() {
+    if (ptr) {
+        ::munmap(const_cast<char*>(ptr), length);
+    }
+    ptr = nullptr;
+    length = 0;
+    opened = false;
+}
@@ -0,0 +1,303 @@
+#include "MarketGenerator.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <spdlog/spdlog.h>
+#include "Utils.h"
+
+namespace {
+
+constexpr size_t kCSVChunkBars = 1 << 20;
+constexpr size_t kMaxRowBytes = 160;
+
+uint64_t rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+uint64_t splitMix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Formats CSV rows; the MM/DD/YYYY part is rebuilt only when the day changes
+class RowFormatter {
+public:
+    char* format(char* p, const Candle& c) {
+        int64_t day = c.timestamp / 86400;
+        int64_t secs = c.timestamp % 86400;
+        if (secs < 0) {
+            secs += 86400;
+            --day;
+        }
+        if (day != cachedDay) {
+            const std::string iso = Utils::formatTimestamp(day * 86400);  // YYYY-MM-DD HH:MM:SS
+            date = iso.substr(5, 2) + "/" + iso.substr(8, 2) + "/" + iso.substr(0, 4);
+            cachedDay = day;
+        }
+
+        p = std::copy(date.begin(), date.end(), p);
+        *p++ = ' ';
+        p = twoDigits(p, secs / 3600);
+        *p++ = ':';
+        p = twoDigits(p, secs / 60 % 60);
+        if (secs % 60) {
+            *p++ = ':';
+            p = twoDigits(p, secs % 60);
+        }
+
+        p = field(p, c.open, 5);
+        p = field(p, c.high, 5);
+        p = field(p, c.low, 5);
+        p = field(p, c.close, 5);
+        *p++ = ',';
+        p = std::to_chars(p, p + 16, c.volume).ptr;
+        p = field(p, (c.close - c.open) * 1e4, 1);  // Change(Pips)
+        p = field(p, c.changePercent, 2);
+        *p++ = ',';
+        *p++ = '\r';
+        *p++ = '\n';
+        return p;
+    }
+
+private:
+    int64_t cachedDay = INT64_MIN;
+    std::string date;
+
+    static char* twoDigits(char* p, int64_t v) {
+        *p++ = static_cast<char>('0' + v / 10);
+        *p++ = static_cast<char>('0' + v % 10);
+        return p;
+    }
+
+    static char* field(char* p, double v, int precision) {
+        *p++ = ',';
+        return std::to_chars(p, p + 32, v, std::chars_format::fixed, precision).ptr;
+    }
+};
+
+} // namespace
+
+MarketGenerator::MarketGenerator(const GeneratorConfig& config) : config(config) {
+    reset();
+}
+
+void MarketGenerator::reset() {
+    uint64_t seed = config.seed;
+    for (auto& s : rngState) s = splitMix64(seed);
+    price = config.startPrice;
+    timestamp = config.startTime;
+    spareNormal = 0.0;
+    hasSpareNormal = false;
+    stressed = false;
+    inPullback = false;
+    trendDirection = 1;
+}
+
+bool MarketGenerator::parseModel(const std::string& name, MarketModel& model) {
+    if (name == "random_walk") model = MarketModel::RandomWalk;
+    else if (name == "gbm") model = MarketModel::GBM;
+    else if (name == "regime") model = MarketModel::RegimeSwitching;
+    else if (name == "trend") model = MarketModel::TrendWithPullbacks;
+    else return false;
+    return true;
+}
+
+// xoshiro256**, mapped to the open interval (0, 1)
+double MarketGenerator::uniform() {
+    const uint64_t result = rotl(rngState[1] * 5, 7) * 9;
+    const uint64_t t = rngState[1] << 17;
+    rngState[2] ^= rngState[0];
+    rngState[3] ^= rngState[1];
+    rngState[1] ^= rngState[2];
+    rngState[0] ^= rngState[3];
+    rngState[2] ^= t;
+    rngState[3] = rotl(rngState[3], 45);
+    return (static_cast<double>(result >> 11) + 0.5) * 0x1.0p-53;
+}
+
+// Marsaglia polar method (no trigonometry); every second call returns the cached twin
+double MarketGenerator::normal() {
+    if (hasSpareNormal) {
+        hasSpareNormal = false;
+        return spareNormal;
+    }
+    double u, v, s;
+    do {
+        u = 2.0 * uniform() - 1.0;
+        v = 2.0 * uniform() - 1.0;
+        s = u * u + v * v;
+    } while (s >= 1.0);
+    const double scale = std::sqrt(-2.0 * std::log(s) / s);
+    spareNormal = v * scale;
+    hasSpareNormal = true;
+    return u * scale;
+}
+
+double MarketGenerator::exponential() {
+    return -std::log(uniform());
+}
+
+double MarketGenerator::nextClose() {
+    double vol = config.volatility;
+    double mu = config.drift;
+
+    switch (config.model) {
+    case MarketModel::RandomWalk: {
+        const double floor = config.startPrice * 0.01;
+        price += vol * config.startPrice * normal();
+        if (price < floor) price = 2 * floor - price;
+        return price;
+    }
+    case MarketModel::GBM:
+        break;
+    case MarketModel::RegimeSwitching:
+        if (uniform() < config.regimeSwitchProbability) stressed = !stressed;
+        if (stressed) {
+            vol *= config.stressedVolatility;
+            mu = config.stressedDrift;
+        }
+        break;
+    case MarketModel::TrendWithPullbacks:
+        // Geometric leg lengths with the configured means
+        if (!inPullback) {
+            if (uniform() * config.trendLength < 1.0) inPullback = true;
+        } else if (uniform() * config.pullbackLength < 1.0) {
+            inPullback = false;
+            if (uniform() < config.reversalProbability) trendDirection = -trendDirection;
+        }
+        mu = inPullback ? -trendDirection * config.pullbackDrift : trendDirection * config.trendDrift;
+        break;
+    }
+
+    price *= std::exp(mu + vol * normal());
+    return price;
+}
+
+Candle MarketGenerator::next() {
+    const double open = price;
+    const double close = nextClose();
+    const double bodyTop = std::max(open, close);
+    const double bodyBottom = std::min(open, close);
+    const double wick = config.volatility * config.wickScale * bodyTop;
+
+    const double high = bodyTop + wick * exponential();
+    double low = bodyBottom - wick * exponential();
+    if (low <= 0) low = bodyBottom * 0.5;
+
+    const int volume = static_cast<int>(config.baseVolume * (0.5 + uniform()));
+    const Candle candle(open, high, low, close, volume, timestamp, (close - open) / open * 100.0);
+    timestamp += config.barSeconds;
+    return candle;
+}
+
+void MarketGenerator::append(size_t bars, CandleSeries& out) {
+    const size_t base = out.size();
+    out.open.resize(base + bars);
+    out.high.resize(base + bars);
+    out.low.resize(base + bars);
+    out.close.resize(base + bars);
+    out.volume.resize(base + bars);
+    out.changePercent.resize(base + bars);
+    out.timestamp.resize(base + bars);
+
+    for (size_t i = base; i < base + bars; ++i) {
+        const Candle c = next();
+        out.open[i] = c.open;
+        out.high[i] = c.high;
+        out.low[i] = c.low;
+        out.close[i] = c.close;
+        out.volume[i] = c.volume;
+        out.changePercent[i] = c.changePercent;
+        out.timestamp[i] = c.timestamp;
+    }
+}
+
+std::vector<Candle> generateCandles(const GeneratorConfig& config, size_t bars) {
+    MarketGenerator generator(config);
+    std::vector<Candle> candles;
+    candles.reserve(bars);
+    for (size_t i = 0; i < bars; ++i) {
+        candles.push_back(generator.next());
+    }
+    return candles;
+}
+
+CandleSeries generateSeries(const GeneratorConfig& config, size_t bars) {
+    MarketGenerator generator(config);
+    CandleSeries series;
+    generator.append(bars, series);
+    return series;
+}
+
+bool writeGeneratedCSV(const std::string& path, const GeneratorConfig& config, size_t bars, const std::string& symbol) {
+    // Rows must be newest first but are generated oldest first: each chunk is written
+    // reversed to a scratch file, then the chunks are copied out in reverse order.
+    const std::string partPath = path + ".part";
+    const std::string tmpPath = path + ".tmp";
+
+    std::vector<uint64_t> chunkBytes;
+    {
+        std::ofstream part(partPath, std::ios::binary | std::ios::trunc);
+        if (!part.is_open()) {
+            spdlog::error("Error opening file for writing: {}", partPath);
+            return false;
+        }
+
+        MarketGenerator generator(config);
+        RowFormatter formatter;
+        std::vector<Candle> chunk;
+        std::vector<char> buffer(kCSVChunkBars * kMaxRowBytes);
+        for (size_t done = 0; done < bars;) {
+            const size_t count = std::min(kCSVChunkBars, bars - done);
+            chunk.clear();
+            for (size_t i = 0; i < count; ++i) chunk.push_back(generator.next());
+
+            char* p = buffer.data();
+            for (size_t i = count; i-- > 0;) p = formatter.format(p, chunk[i]);
+            part.write(buffer.data(), p - buffer.data());
+            chunkBytes.push_back(static_cast<uint64_t>(p - buffer.data()));
+            done += count;
+        }
+        if (!part) {
+            spdlog::error("Error writing file: {}", partPath);
+            std::remove(partPath.c_str());
+            return false;
+        }
+    }
+
+    std::ifstream part(partPath, std::ios::binary);
+    std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+    if (!part.is_open() || !out.is_open()) {
+        spdlog::error("Error opening file for writing: {}", tmpPath);
+        std::remove(partPath.c_str());
+        return false;
+    }
+
+    out << symbol << " Historical Data\r\nDate,Open,High,Low,Close,Volume,Change(Pips),Change(%)\r\n";
+    uint64_t end = 0;
+    for (uint64_t bytes : chunkBytes) end += bytes;
+
+    std::vector<char> buffer;
+    for (size_t k = chunkBytes.size(); k-- > 0;) {
+        end -= chunkBytes[k];
+        buffer.resize(chunkBytes[k]);
+        part.seekg(static_cast<std::streamoff>(end));
+        part.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    }
+
+    const bool ok = part && out.flush();
+    part.close();
+    out.close();
+    std::remove(partPath.c_str());
+    if (!ok || std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        spdlog::error("Error writing file: {}", path);
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
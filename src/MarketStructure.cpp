@@ -1,34 +1,296 @@
 #include "MarketStructure.h"
-#include <unordered_set>
+#include <algorithm>
 #include <cmath>
+#include <functional>
+#include <limits>
 
-// Helper to check significant retracement for CHoCH
-static bool isSignificantRetrace(double price, double swingPrice, double retraceThreshold) {
-    return (price > swingPrice * (1 + retraceThreshold)) || (price < swingPrice * (1 - retraceThreshold));
+namespace col = CandleColumns;
+
+// ==============================
+// SwingDetector
+// ==============================
+
+// Ring sizes are powers of two so positions wrap with a mask
+static size_t ringCapacity(size_t n) {
+    size_t capacity = 1;
+    while (capacity < n) capacity <<= 1;
+    return capacity;
 }
 
-// Detect swing highs and lows
-std::vector<StructurePoint> detectSwingPoints(const std::vector<Candle>& candles, int lookback) {
-    std::vector<StructurePoint> swingPoints;
+void SwingDetector::MonotonicQueue::evictBefore(size_t index) {
+    const size_t mask = ring.size() - 1;
+    while (length > 0 && ring[head].index < index) {
+        head = (head + 1) & mask;
+        --length;
+    }
+}
 
-    for (size_t i = lookback; i < candles.size() - lookback; ++i) {
-        bool isSwingHigh = true;
-        bool isSwingLow = true;
+// Drop entries from the back that `value` dominates, then append it
+template <typename Dominates>
+void SwingDetector::MonotonicQueue::push(size_t index, double value, Dominates dominates) {
+    const size_t mask = ring.size() - 1;
+    while (length > 0 && dominates(value, ring[(head + length - 1) & mask].value)) {
+        --length;
+    }
+    ring[(head + length) & mask] = {index, value};
+    ++length;
+}
 
-        for (int j = 1; j <= lookback; ++j) {
-            if (candles[i].high <= candles[i - j].high || candles[i].high <= candles[i + j].high) {
-                isSwingHigh = false;
-            }
-            if (candles[i].low >= candles[i - j].low || candles[i].low >= candles[i + j].low) {
-                isSwingLow = false;
+SwingDetector::SwingDetector(int lookback)
+    : lookback(lookback) {
+    const size_t window = lookback > 0 ? static_cast<size_t>(lookback) : 1;
+    maxQueue.ring.resize(ringCapacity(window));
+    minQueue.ring.resize(ringCapacity(window));
+
+    const size_t history = ringCapacity(window + 2);
+    highs.resize(history);
+    lows.resize(history);
+    timestamps.resize(history);
+    windowMax.resize(history);
+    windowMin.resize(history);
+}
+
+void SwingDetector::reset() {
+    count = 0;
+    maxQueue.clear();
+    minQueue.clear();
+}
+
+bool SwingDetector::push(double high, double low, int64_t timestamp, StructurePoint& out) {
+    const size_t j = count++;
+    if (lookback < 0) return false;
+
+    const size_t span = static_cast<size_t>(lookback);
+    const size_t mask = highs.size() - 1;
+    const size_t slot = j & mask;
+
+    highs[slot] = high;
+    lows[slot] = low;
+    timestamps[slot] = timestamp;
+
+    // Extrema of bars (j - span, j]; an empty window never blocks a swing
+    double maxHigh = -std::numeric_limits<double>::infinity();
+    double minLow = std::numeric_limits<double>::infinity();
+    if (span > 0) {
+        const size_t windowStart = (j + 1 > span) ? j + 1 - span : 0;
+        maxQueue.evictBefore(windowStart);
+        minQueue.evictBefore(windowStart);
+        maxQueue.push(j, high, [](double a, double b) { return a >= b; });
+        minQueue.push(j, low, [](double a, double b) { return a <= b; });
+        maxHigh = maxQueue.front();
+        minLow = minQueue.front();
+    }
+    windowMax[slot] = maxHigh;
+    windowMin[slot] = minLow;
+
+    // Bar i = j - span has `span` bars on each side once j >= 2 * span
+    if (j < 2 * span) return false;
+
+    const size_t i = j - span;
+    const size_t center = i & mask;
+    const double leftMax = (span > 0) ? windowMax[(i - 1) & mask] : maxHigh;
+    const double leftMin = (span > 0) ? windowMin[(i - 1) & mask] : minLow;
+
+    if (highs[center] > leftMax && highs[center] > maxHigh) {
+        out = {timestamps[center], highs[center], StructureType::SwingHigh, i};
+        return true;
+    }
+    if (lows[center] < leftMin && lows[center] < minLow) {
+        out = {timestamps[center], lows[center], StructureType::SwingLow, i};
+        return true;
+    }
+    return false;
+}
+
+// ==============================
+// CHoCHDetector
+// ==============================
+
+CHoCHDetector::CHoCHDetector(double retraceThreshold)
+    : retraceThreshold(retraceThreshold),
+      lastHigh(std::numeric_limits<double>::quiet_NaN()),
+      lastLow(std::numeric_limits<double>::quiet_NaN()) {}
+
+void CHoCHDetector::reset() {
+    *this = CHoCHDetector(retraceThreshold);
+}
+
+void CHoCHDetector::addSwing(const StructurePoint& swing) {
+    if (std::isnan(swing.price)) return;
+
+    if (swing.type == StructureType::SwingHigh) {
+        if (!std::isnan(lastHigh)) highTrend = swing.price > lastHigh ? 1 : -1;
+        lastHigh = swing.price;
+    } else if (swing.type == StructureType::SwingLow) {
+        if (!std::isnan(lastLow)) lowTrend = swing.price > lastLow ? 1 : -1;
+        lastLow = swing.price;
+    } else {
+        return;
+    }
+
+    // Swings only set the first structure; after that it changes through a CHoCH
+    if (state == Trend::None) {
+        if (highTrend > 0 && lowTrend > 0) state = Trend::Bullish;
+        else if (highTrend < 0 && lowTrend < 0) state = Trend::Bearish;
+    }
+}
+
+bool CHoCHDetector::push(size_t index, double close, int64_t timestamp, StructurePoint& out) {
+    if (state == Trend::Bullish && close < lastLow * (1 - retraceThreshold)) {
+        state = Trend::Bearish;
+    } else if (state == Trend::Bearish && close > lastHigh * (1 + retraceThreshold)) {
+        state = Trend::Bullish;
+    } else {
+        return false;
+    }
+    out = {timestamp, close, StructureType::CHoCH, index};
+    return true;
+}
+
+// ==============================
+// CloseExtremes
+// ==============================
+
+void CloseExtremes::push(double close) {
+    // Bar 0 only holds the identities, so searches start at bar 1
+    if (maxClose.empty()) {
+        maxClose.push_back(-std::numeric_limits<double>::infinity());
+        minClose.push_back(std::numeric_limits<double>::infinity());
+        return;
+    }
+    maxClose.push_back(std::max(maxClose.back(), close));
+    minClose.push_back(std::min(minClose.back(), close));
+}
+
+void CloseExtremes::clear() {
+    maxClose.clear();
+    minClose.clear();
+}
+
+size_t CloseExtremes::firstBreak(const StructurePoint& swing) const {
+    if (size() < 2 || std::isnan(swing.price)) return size();
+
+    if (swing.type == StructureType::SwingHigh) {
+        return static_cast<size_t>(std::upper_bound(maxClose.begin() + 1, maxClose.end(), swing.price) - maxClose.begin());
+    }
+    if (swing.type == StructureType::SwingLow) {
+        return static_cast<size_t>(std::upper_bound(minClose.begin() + 1, minClose.end(), swing.price, std::greater<double>()) -
+                                   minClose.begin());
+    }
+    return size();
+}
+
+// ==============================
+// TrendlineBreakDetector
+// ==============================
+
+TrendlineBreakDetector::TrendlineBreakDetector(double threshold, size_t maxPairSpan)
+    : threshold(threshold), maxPairSpan(maxPairSpan) {}
+
+void TrendlineBreakDetector::reset() {
+    recentHighs.clear();
+    recentLows.clear();
+    reported.clear();
+    reportedBase = 0;
+}
+
+size_t TrendlineBreakDetector::addSwing(const StructurePoint& swing, const std::vector<Candle>& candles, std::vector<StructurePoint>& out) {
+    return addSwingImpl(swing, candles, out);
+}
+
+size_t TrendlineBreakDetector::addSwing(const StructurePoint& swing, const CandleSeries& candles, std::vector<StructurePoint>& out) {
+    return addSwingImpl(swing, candles, out);
+}
+
+template <typename Series>
+size_t TrendlineBreakDetector::addSwingImpl(const StructurePoint& swing, const Series& candles, std::vector<StructurePoint>& out) {
+    const bool isHigh = swing.type == StructureType::SwingHigh;
+    if (!isHigh && swing.type != StructureType::SwingLow) return 0;
+
+    std::vector<StructurePoint>& pivots = isHigh ? recentHighs : recentLows;
+    scratch.clear();
+
+    double x2 = static_cast<double>(swing.index);
+    double y2 = swing.price;
+
+    for (const auto& pivot : pivots) {
+        double x1 = static_cast<double>(pivot.index);
+        double y1 = pivot.price;
+        double slope = (y2 - y1) / (x2 - x1);
+
+        // k > pivot.index >= reportedBase
+        for (size_t k = pivot.index + 1; k < swing.index; ++k) {
+            const size_t slot = k - reportedBase;
+            if (slot < reported.size() && reported[slot]) continue;
+
+            double trendPrice = y1 + slope * (k - x1);
+            double close = col::close(candles, k);
+
+            if ((isHigh && close > trendPrice * (1 + threshold)) ||
+                (!isHigh && close < trendPrice * (1 - threshold))) {
+                if (slot >= reported.size()) reported.resize(slot + 1, 0);
+                reported[slot] = 1;
+                scratch.push_back(k);
             }
         }
+    }
+
+    if (maxPairSpan > 0) {
+        if (pivots.size() == maxPairSpan) pivots.erase(pivots.begin());
+        pivots.push_back(swing);
+    }
+
+    // Later swings only test bars after the oldest pivot of either type (or after this swing)
+    size_t base = swing.index;
+    if (!recentHighs.empty()) base = std::min(base, recentHighs.front().index);
+    if (!recentLows.empty()) base = std::min(base, recentLows.front().index);
+    if (base > reportedBase) {
+        reported.erase(reported.begin(), reported.begin() + static_cast<std::ptrdiff_t>(std::min(base - reportedBase, reported.size())));
+        reportedBase = base;
+    }
+
+    // Older pivots cover wider ranges, so merge their hits into index order
+    std::sort(scratch.begin(), scratch.end());
+    for (size_t k : scratch) {
+        out.push_back({col::timestamp(candles, k), col::close(candles, k), StructureType::TrendlineBreak, k});
+    }
+    return scratch.size();
+}
+
+namespace {
+
+// Detect swing highs and lows
+template <typename Series>
+std::vector<StructurePoint> swingPointsImpl(const Series& candles, int lookback) {
+    std::vector<StructurePoint> swingPoints;
+    SwingDetector detector(lookback);
+    StructurePoint point;
 
-        if (isSwingHigh) {
-            swingPoints.push_back({candles[i].date, candles[i].high, StructureType::SwingHigh, i});
+    for (size_t i = 0; i < col::size(candles); ++i) {
+        if (detector.push(col::high(candles, i), col::low(candles, i), col::timestamp(candles, i), point)) {
+            swingPoints.push_back(point);
         }
-        else if (isSwingLow) {
-            swingPoints.push_back({candles[i].date, candles[i].low, StructureType::SwingLow, i});
+    }
+
+    return swingPoints;
+}
+
+// Swing points for several lookbacks, one pass over the bars
+template <typename Series>
+std::vector<std::vector<StructurePoint>> swingPointsMultiImpl(const Series& candles, const std::vector<int>& lookbacks) {
+    std::vector<SwingDetector> detectors(lookbacks.begin(), lookbacks.end());
+    std::vector<std::vector<StructurePoint>> swingPoints(lookbacks.size());
+    StructurePoint point;
+
+    for (size_t i = 0; i < col::size(candles); ++i) {
+        const double high = col::high(candles, i);
+        const double low = col::low(candles, i);
+        const int64_t timestamp = col::timestamp(candles, i);
+
+        for (size_t k = 0; k < detectors.size(); ++k) {
+            if (detectors[k].push(high, low, timestamp, point)) {
+                swingPoints[k].push_back(point);
+            }
         }
     }
 
@@ -36,44 +298,102 @@ std::vector<StructurePoint> detectSwingPoints(const std::vector<Candle>& candles
 }
 
 // Detect Break of Structure (BOS)
-std::vector<StructurePoint> detectBOS(const std::vector<Candle>& candles, const std::vector<StructurePoint>& swingPoints) {
+// Untriggered swing highs are kept sorted by ascending price and swing lows by
+// descending price, so each candle pops exactly the swings its close breaks:
+// O((n + s) log s) instead of O(n * s). Every BOS emitted on a candle carries that
+// candle's close, so the output matches the pairwise scan point for point.
+// Swings sharing an index trigger once, like the previous per-index set.
+template <typename Series>
+std::vector<StructurePoint> bosImpl(const Series& candles, const std::vector<StructurePoint>& swingPoints) {
+    struct ActiveSwing {
+        double price;
+        size_t group;   // dense id of swing.index
+    };
+
+    std::vector<size_t> indices;
+    indices.reserve(swingPoints.size());
+    for (const auto& swing : swingPoints) indices.push_back(swing.index);
+    std::sort(indices.begin(), indices.end());
+    indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+
+    std::vector<ActiveSwing> highs, lows;
+    for (const auto& swing : swingPoints) {
+        if (std::isnan(swing.price)) continue;  // never broken
+        size_t group = static_cast<size_t>(std::lower_bound(indices.begin(), indices.end(), swing.index) - indices.begin());
+        if (swing.type == StructureType::SwingHigh) highs.push_back({swing.price, group});
+        else if (swing.type == StructureType::SwingLow) lows.push_back({swing.price, group});
+    }
+    std::sort(highs.begin(), highs.end(), [](const ActiveSwing& x, const ActiveSwing& y) { return x.price < y.price; });
+    std::sort(lows.begin(), lows.end(), [](const ActiveSwing& x, const ActiveSwing& y) { return x.price > y.price; });
+
     std::vector<StructurePoint> bosPoints;
-    std::unordered_set<size_t> triggered; // To avoid duplicate BOS from same swing point
+    std::vector<char> triggered(indices.size(), 0); // To avoid duplicate BOS from same swing point
+    size_t nextHigh = 0;
+    size_t nextLow = 0;
 
-    for (size_t i = 1; i < candles.size(); ++i) {
-        for (const auto& swing : swingPoints) {
-            if (triggered.count(swing.index)) continue;
+    for (size_t i = 1; i < col::size(candles) && (nextHigh < highs.size() || nextLow < lows.size()); ++i) {
+        const double close = col::close(candles, i);
+        size_t broken = 0;
 
-            if (swing.type == StructureType::SwingHigh && candles[i].close > swing.price) {
-                bosPoints.push_back({candles[i].date, candles[i].close, StructureType::BOS, i});
-                triggered.insert(swing.index);
+        for (; nextHigh < highs.size() && highs[nextHigh].price < close; ++nextHigh) {
+            if (!triggered[highs[nextHigh].group]) {
+                triggered[highs[nextHigh].group] = 1;
+                ++broken;
             }
-            else if (swing.type == StructureType::SwingLow && candles[i].close < swing.price) {
-                bosPoints.push_back({candles[i].date, candles[i].close, StructureType::BOS, i});
-                triggered.insert(swing.index);
+        }
+        for (; nextLow < lows.size() && lows[nextLow].price > close; ++nextLow) {
+            if (!triggered[lows[nextLow].group]) {
+                triggered[lows[nextLow].group] = 1;
+                ++broken;
             }
         }
+
+        if (broken > 0) {
+            bosPoints.insert(bosPoints.end(), broken, StructurePoint{col::timestamp(candles, i), close, StructureType::BOS, i});
+        }
     }
 
     return bosPoints;
 }
 
-// Detect Change of Character (CHoCH)
-std::vector<StructurePoint> detectCHoCH(const std::vector<Candle>& candles, const std::vector<StructurePoint>& swingPoints, double retraceThreshold) {
+// The first close beyond each swing index; swings sharing an index break once, as in bosImpl
+template <typename Series>
+std::vector<KnownBOS> bosKnownBarsImpl(const Series& candles, const std::vector<StructurePoint>& swingPoints, int lookback) {
+    CloseExtremes closes;
+    for (size_t i = 0; i < col::size(candles); ++i) closes.push(col::close(candles, i));
+
+    const size_t n = closes.size();
+    const size_t lag = lookback > 0 ? static_cast<size_t>(lookback) : 0;
+    std::vector<KnownBOS> known;
+    for (size_t k = 0; k < swingPoints.size();) {
+        const size_t index = swingPoints[k].index;
+        size_t bar = n;
+        for (; k < swingPoints.size() && swingPoints[k].index == index; ++k) {
+            bar = std::min(bar, closes.firstBreak(swingPoints[k]));
+        }
+        if (bar < n) known.push_back({bar, std::max(bar, index + lag)});
+    }
+    return known;
+}
+
+// Detect Change of Character (CHoCH): one pass, swings applied in index order
+template <typename Series>
+std::vector<StructurePoint> chochImpl(const Series& candles, const std::vector<StructurePoint>& swingPoints, double retraceThreshold) {
+    std::vector<const StructurePoint*> swings;
+    swings.reserve(swingPoints.size());
+    for (const auto& swing : swingPoints) swings.push_back(&swing);
+    std::stable_sort(swings.begin(), swings.end(),
+                     [](const StructurePoint* a, const StructurePoint* b) { return a->index < b->index; });
+
     std::vector<StructurePoint> chochPoints;
+    CHoCHDetector detector(retraceThreshold);
+    StructurePoint point;
+    size_t next = 0;
 
-    for (size_t i = 1; i < candles.size(); ++i) {
-        for (const auto& swing : swingPoints) {
-            if (swing.type == StructureType::SwingHigh && candles[i].close < swing.price &&
-                isSignificantRetrace(candles[i].close, swing.price, retraceThreshold)) {
-                chochPoints.push_back({candles[i].date, candles[i].close, StructureType::CHoCH, i});
-                break; // Avoid multiple CHoCH from same candle
-            }
-            else if (swing.type == StructureType::SwingLow && candles[i].close > swing.price &&
-                isSignificantRetrace(candles[i].close, swing.price, retraceThreshold)) {
-                chochPoints.push_back({candles[i].date, candles[i].close, StructureType::CHoCH, i});
-                break;
-            }
+    for (size_t i = 1; i < col::size(candles); ++i) {
+        for (; next < swings.size() && swings[next]->index < i; ++next) detector.addSwing(*swings[next]);
+        if (detector.push(i, col::close(candles, i), col::timestamp(candles, i), point)) {
+            chochPoints.push_back(point);
         }
     }
 
@@ -81,8 +401,9 @@ std::vector<StructurePoint> detectCHoCH(const std::vector<Candle>& candles, cons
 }
 
 // Detect trendline breaks between swing points of the same type
-std::vector<StructurePoint> detectTrendlineBreak(
-    const std::vector<Candle>& candles,
+template <typename Series>
+std::vector<StructurePoint> trendlineBreakImpl(
+    const Series& candles,
     const std::vector<StructurePoint>& swingPoints,
     double threshold
 ) {
@@ -102,13 +423,13 @@ std::vector<StructurePoint> detectTrendlineBreak(
 
                 for (size_t k = static_cast<size_t>(x1) + 1; k < static_cast<size_t>(x2); ++k) {
                     double trendPrice = y1 + slope * (k - x1);
-                    double close = candles[k].close;
+                    double close = col::close(candles, k);
 
                     if (swingPoints[i].type == StructureType::SwingHigh && close > trendPrice * (1 + threshold)) {
-                        breaks.push_back({candles[k].date, close, StructureType::TrendlineBreak, k});
+                        breaks.push_back({col::timestamp(candles, k), close, StructureType::TrendlineBreak, k});
                     }
                     else if (swingPoints[i].type == StructureType::SwingLow && close < trendPrice * (1 - threshold)) {
-                        breaks.push_back({candles[k].date, close, StructureType::TrendlineBreak, k});
+                        breaks.push_back({col::timestamp(candles, k), close, StructureType::TrendlineBreak, k});
                     }
                 }
             }
@@ -118,17 +439,38 @@ std::vector<StructurePoint> detectTrendlineBreak(
     return breaks;
 }
 
+// Trendline breaks over bounded pivot pairs, one per candle
+template <typename Series>
+std::vector<StructurePoint> boundedTrendlineBreaksImpl(
+    const Series& candles,
+    const std::vector<StructurePoint>& swingPoints,
+    double threshold,
+    size_t maxPairSpan
+) {
+    std::vector<StructurePoint> breaks;
+    TrendlineBreakDetector detector(threshold, maxPairSpan);
+
+    for (const auto& swing : swingPoints) {
+        detector.addSwing(swing, candles, breaks);
+    }
+
+    // Highs and lows interleave; restore candle order
+    std::sort(breaks.begin(), breaks.end(), [](const StructurePoint& a, const StructurePoint& b) { return a.index < b.index; });
+    return breaks;
+}
+
 // Generic detector routing
-std::vector<StructurePoint> detectStructure(const std::vector<Candle>& candles, StructureType type, double retraceThreshold) {
-    std::vector<StructurePoint> swingPoints = detectSwingPoints(candles, 2);
+template <typename Series>
+std::vector<StructurePoint> structureImpl(const Series& candles, StructureType type, double retraceThreshold) {
+    std::vector<StructurePoint> swingPoints = swingPointsImpl(candles, 2);
 
     switch (type) {
         case StructureType::CHoCH:
-            return detectCHoCH(candles, swingPoints, retraceThreshold);
+            return chochImpl(candles, swingPoints, retraceThreshold);
         case StructureType::BOS:
-            return detectBOS(candles, swingPoints);
+            return bosImpl(candles, swingPoints);
         case StructureType::TrendlineBreak:
-            return detectTrendlineBreak(candles, swingPoints, retraceThreshold);
+            return trendlineBreakImpl(candles, swingPoints, retraceThreshold);
         case StructureType::SwingHigh:
         case StructureType::SwingLow:
             return swingPoints;
@@ -136,3 +478,71 @@ std::vector<StructurePoint> detectStructure(const std::vector<Candle>& candles,
             return {};
     }
 }
+
+} // namespace
+
+std::vector<StructurePoint> detectSwingPoints(const std::vector<Candle>& candles, int lookback) {
+    return swingPointsImpl(candles, lookback);
+}
+
+std::vector<StructurePoint> detectSwingPoints(const CandleSeries& candles, int lookback) {
+    return swingPointsImpl(candles, lookback);
+}
+
+std::vector<std::vector<StructurePoint>> detectSwingPointsMulti(const std::vector<Candle>& candles, const std::vector<int>& lookbacks) {
+    return swingPointsMultiImpl(candles, lookbacks);
+}
+
+std::vector<std::vector<StructurePoint>> detectSwingPointsMulti(const CandleSeries& candles, const std::vector<int>& lookbacks) {
+    return swingPointsMultiImpl(candles, lookbacks);
+}
+
+std::vector<KnownBOS> bosKnownBars(const std::vector<Candle>& candles, const std::vector<StructurePoint>& swingPoints, int lookback) {
+    return bosKnownBarsImpl(candles, swingPoints, lookback);
+}
+
+std::vector<KnownBOS> bosKnownBars(const CandleSeries& candles, const std::vector<StructurePoint>& swingPoints, int lookback) {
+    return bosKnownBarsImpl(candles, swingPoints, lookback);
+}
+
+std::vector<StructurePoint> detectBOS(const std::vector<Candle>& candles, const std::vector<StructurePoint>& swingPoints) {
+    return bosImpl(candles, swingPoints);
+}
+
+std::vector<StructurePoint> detectBOS(const CandleSeries& candles, const std::vector<StructurePoint>& swingPoints) {
+    return bosImpl(candles, swingPoints);
+}
+
+std::vector<StructurePoint> detectCHoCH(const std::vector<Candle>& candles, const std::vector<StructurePoint>& swingPoints, double retraceThreshold) {
+    return chochImpl(candles, swingPoints, retraceThreshold);
+}
+
+std::vector<StructurePoint> detectCHoCH(const CandleSeries& candles, const std::vector<StructurePoint>& swingPoints, double retraceThreshold) {
+    return chochImpl(candles, swingPoints, retraceThreshold);
+}
+
+std::vector<StructurePoint> detectTrendlineBreak(const std::vector<Candle>& candles, const std::vector<StructurePoint>& swingPoints, double threshold) {
+    return trendlineBreakImpl(candles, swingPoints, threshold);
+}
+
+std::vector<StructurePoint> detectTrendlineBreak(const CandleSeries& candles, const std::vector<StructurePoint>& swingPoints, double threshold) {
+    return trendlineBreakImpl(candles, swingPoints, threshold);
+}
+
+std::vector<StructurePoint> detectBoundedTrendlineBreaks(const std::vector<Candle>& candles, const std::vector<StructurePoint>& swingPoints,
+                                                         double threshold, size_t maxPairSpan) {
+    return boundedTrendlineBreaksImpl(candles, swingPoints, threshold, maxPairSpan);
+}
+
+std::vector<StructurePoint> detectBoundedTrendlineBreaks(const CandleSeries& candles, const std::vector<StructurePoint>& swingPoints,
+                                                         double threshold, size_t maxPairSpan) {
+    return boundedTrendlineBreaksImpl(candles, swingPoints, threshold, maxPairSpan);
+}
+
+std::vector<StructurePoint> detectStructure(const std::vector<Candle>& candles, StructureType type, double retraceThreshold) {
+    return structureImpl(candles, type, retraceThreshold);
+}
+
+std::vector<StructurePoint> detectStructure(const CandleSeries& candles, StructureType type, double retraceThreshold) {
+    return structureImpl(candles, type, retraceThreshold);
+}
@@ -0,0 +1,91 @@
+#include "MultiSymbolRunner.h"
+#include <algorithm>
+#include <spdlog/spdlog.h>
+#include "AsyncLog.h"
+
+namespace
+{
+    size_t poolSize(const Config &config)
+    {
+        // Never more threads than symbols; 0 lets the pool use every core
+        size_t threads = static_cast<size_t>(config.worker_threads);
+        if (threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        return std::min(threads, std::max<size_t>(config.instruments.size(), 1));
+    }
+}
+
+MultiSymbolRunner::MultiSymbolRunner(const Config &config)
+    : pool(poolSize(config))
+{
+    // Symbol loggers share one sink, so whole lines from different threads never mix
+    // (and with AsyncLog started, none of them waits for the console)
+    auto sink = AsyncLog::consoleSink("%^%l%$ [%Y-%m-%d %H:%M:%S] [%n] %v");
+
+    analyzers.reserve(config.instruments.size());
+    for (const auto &instrument : config.instruments)
+    {
+        std::shared_ptr<spdlog::logger> logger;
+        if (!instrument.symbol.empty())
+        {
+            logger = std::make_shared<spdlog::logger>(instrument.symbol, sink);
+            logger->set_level(spdlog::default_logger()->level());
+        }
+
+        const Config symbolConfig = config.forInstrument(instrument);
+        analyzers.push_back(std::make_unique<OrderBlockAnalyzer>(symbolConfig, logger));
+        symbols.push_back(instrument.symbol);
+
+        if (analyzers.back()->fetchesFromAPI())
+        {
+            fetcher.add(symbolConfig.api_endpoint);
+            fetchedAnalyzer.push_back(analyzers.size() - 1);
+        }
+    }
+
+    spdlog::info("Analyzing {} symbol(s) on {} worker thread(s).", analyzers.size(), pool.size());
+}
+
+void MultiSymbolRunner::runCycle()
+{
+    // File sources start right away
+    for (size_t i = 0; i < analyzers.size(); ++i)
+    {
+        if (!analyzers[i]->fetchesFromAPI())
+            submit(i);
+    }
+
+    // API sources are requested concurrently; each symbol is analyzed as its response lands
+    if (fetcher.size() > 0)
+    {
+        // Cached symbols only ask for the bars after what they already have
+        for (size_t source = 0; source < fetcher.size(); ++source)
+            fetcher.setUrl(source, analyzers[fetchedAnalyzer[source]]->apiRequestUrl());
+
+        fetcher.fetchAll([this](size_t source, std::vector<Candle> &&candles, bool)
+                         {
+                             // A failed fetch (already reported) is analyzed as no data, like a direct read
+                             const size_t i = fetchedAnalyzer[source];
+                             analyzers[i]->supplyAPIResponse(std::move(candles));
+                             submit(i);
+                         });
+    }
+    pool.wait();
+}
+
+void MultiSymbolRunner::submit(size_t i)
+{
+    OrderBlockAnalyzer *analyzer = analyzers[i].get();
+    const std::string *symbol = &symbols[i];
+    pool.submit([analyzer, symbol]()
+                {
+                    try
+                    {
+                        analyzer->analyze();
+                    }
+                    catch (const std::exception &e)
+                    {
+                        spdlog::error("Exception during analysis of {}: {}", symbol->empty() ? "instrument" : *symbol, e.what());
+                    }
+                });
+}
@@ -1,9 +1,13 @@
 #include "Order.h"
-#include <iostream>
+#include <spdlog/spdlog.h>
 
-// Constructor to initialize the order with type, price, date, stop loss, and take profit
-Order::Order(Type type, double price, const std::string& date, double stopLoss, double takeProfit)
-    : orderType(type), entryPrice(price), orderDate(date), stopLoss(stopLoss), takeProfit(takeProfit), status(Status::PENDING) {}
+// Constructor to initialize the order with type, price, timestamp, stop loss, and take profit
+Order::Order(Type type, double price, int64_t timestamp, double stopLoss, double takeProfit)
+    : Order(type, price, timestamp, stopLoss, takeProfit, timestamp) {}
+
+Order::Order(Type type, double price, int64_t timestamp, double stopLoss, double takeProfit, int64_t activationTimestamp)
+    : orderType(type), entryPrice(price), orderTimestamp(timestamp), activationTimestamp(activationTimestamp),
+      stopLoss(stopLoss), takeProfit(takeProfit), status(Status::PENDING) {}
 
 // Getter for order type
 Order::Type Order::getType() const {
@@ -15,9 +19,14 @@ double Order::getEntryPrice() const {
     return entryPrice;
 }
 
-// Getter for order date
-const std::string& Order::getOrderDate() const {
-    return orderDate;
+// Getter for order timestamp
+int64_t Order::getOrderTimestamp() const {
+    return orderTimestamp;
+}
+
+// Getter for activation timestamp
+int64_t Order::getActivationTimestamp() const {
+    return activationTimestamp;
 }
 
 // Getter for stop loss
@@ -39,10 +48,10 @@ Order::Status Order::getStatus() const {
 void Order::execute() {
     if (status == Status::PENDING) {
         status = Status::EXECUTED;
-        std::cout << "Order executed at price: " << entryPrice << std::endl;
+        spdlog::info("Order executed at price: {}", entryPrice);
     }
     else {
-        std::cout << "Order cannot be executed because it is not pending." << std::endl;
+        spdlog::warn("Order cannot be executed because it is not pending.");
     }
 }
 
@@ -50,9 +59,9 @@ void Order::execute() {
 void Order::cancel() {
     if (status == Status::PENDING) {
         status = Status::CANCELLED;
-        std::cout << "Order cancelled." << std::endl;
+        spdlog::info("Order cancelled.");
     }
     else {
-        std::cout << "Order cannot be cancelled because it is already executed or cancelled." << std::endl;
+        spdlog::warn("Order cannot be cancelled because it is already executed or cancelled.");
     }
 }
@@ -1,5 +1,153 @@
 #include "OrderBlock.h"
 #include <algorithm>
+#include <cstdint>
+
+namespace col = CandleColumns;
+
+namespace {
+
+// Impulse checks on rows c1, c2 of a series (same rules as the Candle overloads)
+template <typename Series>
+bool strongBullishImpulseAt(const Series& s, size_t c1, size_t c2) {
+    return col::isBullish(s, c1) && col::isBullish(s, c2) &&
+           std::abs(col::close(s, c2) - col::open(s, c2)) > std::abs(col::close(s, c1) - col::open(s, c1));
+}
+
+template <typename Series>
+bool strongBearishImpulseAt(const Series& s, size_t c1, size_t c2) {
+    return col::isBearish(s, c1) && col::isBearish(s, c2) &&
+           std::abs(col::open(s, c2) - col::close(s, c2)) > std::abs(col::open(s, c1) - col::close(s, c1));
+}
+
+// Build the zone for the order-block candle at row i
+template <typename Series>
+OBZone obZoneAt(const Series& s, size_t i, OBType type) {
+    OBZone zone;
+    zone.top = std::max(col::high(s, i), col::open(s, i));
+    zone.bottom = std::min(col::low(s, i), col::close(s, i));
+    zone.timestamp = col::timestamp(s, i);
+    zone.type = type;
+
+    double body = std::abs(col::close(s, i) - col::open(s, i));
+    double range = col::high(s, i) - col::low(s, i);
+    zone.score = (range > 0) ? body / range : 0.0;
+
+    return zone;
+}
+
+// Find bullish order blocks
+template <typename Series>
+std::vector<OBZone> bullishOrderBlocksImpl(const Series& candles) {
+    std::vector<OBZone> bullishOrderBlocks;
+
+    for (size_t i = 2; i < col::size(candles); ++i) {
+        if (col::isBearish(candles, i) && strongBullishImpulseAt(candles, i - 1, i - 2)) {
+            bullishOrderBlocks.push_back(obZoneAt(candles, i, OBType::Bullish));
+        }
+    }
+
+    return bullishOrderBlocks;
+}
+
+// Find bearish order blocks
+template <typename Series>
+std::vector<OBZone> bearishOrderBlocksImpl(const Series& candles) {
+    std::vector<OBZone> bearishOrderBlocks;
+
+    for (size_t i = 2; i < col::size(candles); ++i) {
+        if (col::isBullish(candles, i) && strongBearishImpulseAt(candles, i - 1, i - 2)) {
+            bearishOrderBlocks.push_back(obZoneAt(candles, i, OBType::Bearish));
+        }
+    }
+
+    return bearishOrderBlocks;
+}
+
+// Order blocks formed at candle i, confirmed by candles i + 1 and i + 2
+template <typename Series>
+void orderBlocksAt(const Series& candles, size_t i, std::vector<std::pair<OBZone, std::string>>& orderBlocks) {
+    if (col::isBearish(candles, i) && strongBullishImpulseAt(candles, i + 1, i + 2)) {
+        orderBlocks.emplace_back(obZoneAt(candles, i, OBType::Bullish), "Bullish");
+    }
+
+    if (col::isBullish(candles, i) && strongBearishImpulseAt(candles, i + 1, i + 2)) {
+        orderBlocks.emplace_back(obZoneAt(candles, i, OBType::Bearish), "Bearish");
+    }
+}
+
+// Detect both bullish and bearish order blocks
+template <typename Series>
+std::vector<std::pair<OBZone, std::string>> orderBlocksImpl(const Series& candles) {
+    std::vector<std::pair<OBZone, std::string>> orderBlocks;
+
+    for (size_t i = 0; i + 2 < col::size(candles); ++i) {
+        orderBlocksAt(candles, i, orderBlocks);
+    }
+
+    return orderBlocks;
+}
+
+// Confirm OBs with CHoCH and BOS structure: zones and structure points are
+// swept together in time order through an OrderBlockConfirmer
+template <typename Series>
+std::vector<ConfirmedOB> filterWithStructureImpl(
+    const Series& candles,
+    const std::vector<std::pair<OBZone, std::string>>& rawOBs,
+    const std::vector<StructurePoint>& choch,
+    const std::vector<StructurePoint>& bos
+) {
+    struct Point {
+        const StructurePoint* point;
+        int kind;  // 0 = CHoCH, 1 = BOS (CHoCH first on the same bar)
+    };
+    std::vector<Point> points;
+    points.reserve(choch.size() + bos.size());
+    for (const auto& ch : choch) {
+        if (ch.type == StructureType::CHoCH && ch.index > 0 && ch.index < col::size(candles)) points.push_back({&ch, 0});
+    }
+    for (const auto& b : bos) {
+        if (b.type == StructureType::BOS && b.index > 0 && b.index < col::size(candles)) points.push_back({&b, 1});
+    }
+    std::sort(points.begin(), points.end(), [](const Point& a, const Point& b) {
+        return a.point->index < b.point->index || (a.point->index == b.point->index && a.kind < b.kind);
+    });
+
+    std::vector<size_t> zones(rawOBs.size());
+    for (size_t k = 0; k < zones.size(); ++k) zones[k] = k;
+    std::stable_sort(zones.begin(), zones.end(), [&](size_t a, size_t b) {
+        return rawOBs[a].first.timestamp < rawOBs[b].first.timestamp;
+    });
+
+    OrderBlockConfirmer confirmer;
+    std::vector<size_t> rawIndex;  // by ticket
+    std::vector<ConfirmedOB> found;
+    std::vector<size_t> tickets;
+    size_t nextZone = 0;
+    for (const auto& p : points) {
+        // The point's timestamp is the candle's, so zones formed before it are pending
+        StructurePoint point = *p.point;
+        point.timestamp = col::timestamp(candles, point.index);
+        for (; nextZone < zones.size() && rawOBs[zones[nextZone]].first.timestamp < point.timestamp; ++nextZone) {
+            const auto& [zone, dir] = rawOBs[zones[nextZone]];
+            confirmer.addOrderBlock(zone, dir);
+            rawIndex.push_back(zones[nextZone]);
+        }
+        if (confirmer.pendingCount() > 0) confirmer.addStructurePoint(point, found, &tickets);
+    }
+
+    // Back to the order of rawOBs
+    std::vector<size_t> slot(rawOBs.size(), SIZE_MAX);
+    for (size_t k = 0; k < found.size(); ++k) slot[rawIndex[tickets[k]]] = k;
+
+    std::vector<ConfirmedOB> confirmedOBs;
+    confirmedOBs.reserve(found.size());
+    for (size_t k : slot) {
+        if (k != SIZE_MAX) confirmedOBs.push_back(std::move(found[k]));
+    }
+    return confirmedOBs;
+}
+
+} // namespace
 
 // Detect strong bullish impulse
 bool isStrongBullishImpulse(const Candle& c1, const Candle& c2) {
@@ -18,7 +166,7 @@ OBZone getBullishOBZone(const Candle& ob) {
     OBZone zone;
     zone.top = std::max(ob.high, ob.open);
     zone.bottom = std::min(ob.low, ob.close);
-    zone.date = ob.date;
+    zone.timestamp = ob.timestamp;
     zone.type = OBType::Bullish;
 
     double body = std::abs(ob.close - ob.open);
@@ -33,7 +181,7 @@ OBZone getBearishOBZone(const Candle& ob) {
     OBZone zone;
     zone.top = std::max(ob.high, ob.open);
     zone.bottom = std::min(ob.low, ob.close);
-    zone.date = ob.date;
+    zone.timestamp = ob.timestamp;
     zone.type = OBType::Bearish;
 
     double body = std::abs(ob.close - ob.open);
@@ -43,115 +191,104 @@ OBZone getBearishOBZone(const Candle& ob) {
     return zone;
 }
 
-// Find bullish order blocks
 std::vector<OBZone> findBullishOrderBlocks(const std::vector<Candle>& candles) {
-    std::vector<OBZone> bullishOrderBlocks;
-
-    for (size_t i = 2; i < candles.size(); ++i) {
-        const Candle& ob = candles[i];
-        const Candle& c1 = candles[i - 1];
-        const Candle& c2 = candles[i - 2];
-
-        if (ob.isBearish() && isStrongBullishImpulse(c1, c2)) {
-            OBZone zone = getBullishOBZone(ob);
-            bullishOrderBlocks.push_back(zone);
-        }
-    }
+    return bullishOrderBlocksImpl(candles);
+}
 
-    return bullishOrderBlocks;
+std::vector<OBZone> findBullishOrderBlocks(const CandleSeries& candles) {
+    return bullishOrderBlocksImpl(candles);
 }
 
-// Find bearish order blocks
 std::vector<OBZone> findBearishOrderBlocks(const std::vector<Candle>& candles) {
-    std::vector<OBZone> bearishOrderBlocks;
-
-    for (size_t i = 2; i < candles.size(); ++i) {
-        const Candle& ob = candles[i];
-        const Candle& c1 = candles[i - 1];
-        const Candle& c2 = candles[i - 2];
-
-        if (ob.isBullish() && isStrongBearishImpulse(c1, c2)) {
-            OBZone zone = getBearishOBZone(ob);
-            bearishOrderBlocks.push_back(zone);
-        }
-    }
+    return bearishOrderBlocksImpl(candles);
+}
 
-    return bearishOrderBlocks;
+std::vector<OBZone> findBearishOrderBlocks(const CandleSeries& candles) {
+    return bearishOrderBlocksImpl(candles);
 }
 
-// Detect both bullish and bearish order blocks
 std::vector<std::pair<OBZone, std::string>> detectOrderBlocks(const std::vector<Candle>& candles) {
-    std::vector<std::pair<OBZone, std::string>> orderBlocks;
-
-    for (size_t i = 0; i + 2 < candles.size(); ++i) {
-        const Candle& ob = candles[i];
-        const Candle& c1 = candles[i + 1];
-        const Candle& c2 = candles[i + 2];
-
-        if (ob.isBearish() && isStrongBullishImpulse(c1, c2)) {
-            OBZone bullishZone = getBullishOBZone(ob);
-            orderBlocks.emplace_back(bullishZone, "Bullish");
-        }
+    return orderBlocksImpl(candles);
+}
 
-        if (ob.isBullish() && isStrongBearishImpulse(c1, c2)) {
-            OBZone bearishZone = getBearishOBZone(ob);
-            orderBlocks.emplace_back(bearishZone, "Bearish");
-        }
-    }
+std::vector<std::pair<OBZone, std::string>> detectOrderBlocks(const CandleSeries& candles) {
+    return orderBlocksImpl(candles);
+}
 
-    return orderBlocks;
+void detectOrderBlocksAt(const CandleSeries& candles, size_t i, std::vector<std::pair<OBZone, std::string>>& out) {
+    orderBlocksAt(candles, i, out);
 }
 
-// Confirm OBs with CHoCH and BOS structure
 std::vector<ConfirmedOB> filterOrderBlocksWithStructure(
     const std::vector<Candle>& candles,
     const std::vector<std::pair<OBZone, std::string>>& rawOBs,
     const std::vector<StructurePoint>& choch,
     const std::vector<StructurePoint>& bos
 ) {
-    std::vector<ConfirmedOB> confirmedOBs;
+    return filterWithStructureImpl(candles, rawOBs, choch, bos);
+}
 
-    for (const auto& [zone, dir] : rawOBs) {
-        ConfirmationType confType = ConfirmationType::None;
-        std::string confDate = "";
-
-        for (const auto& ch : choch) {
-            if (ch.type == StructureType::CHoCH &&
-                ((zone.type == OBType::Bullish && ch.price > zone.top) ||
-                 (zone.type == OBType::Bearish && ch.price < zone.bottom)) &&
-                ch.index > 0)
-            {
-                confType = ConfirmationType::CHoCH;
-                confDate = candles[ch.index].date;
-                break;
-            }
-        }
+std::vector<ConfirmedOB> filterOrderBlocksWithStructure(
+    const CandleSeries& candles,
+    const std::vector<std::pair<OBZone, std::string>>& rawOBs,
+    const std::vector<StructurePoint>& choch,
+    const std::vector<StructurePoint>& bos
+) {
+    return filterWithStructureImpl(candles, rawOBs, choch, bos);
+}
 
-        if (confType == ConfirmationType::None) {
-            for (const auto& b : bos) {
-                if (b.type == StructureType::BOS &&
-                    ((zone.type == OBType::Bullish && b.price > zone.top) ||
-                     (zone.type == OBType::Bearish && b.price < zone.bottom)) &&
-                    b.index > 0)
-                {
-                    confType = ConfirmationType::BOS;
-                    confDate = candles[b.index].date;
-                    break;
-                }
-            }
-        }
+// ==============================
+// OrderBlockConfirmer
+// ==============================
+
+size_t OrderBlockConfirmer::addOrderBlock(const OBZone& zone, const std::string& direction) {
+    const size_t ticket = nextTicket++;
+    if (zone.type == OBType::Bullish) bullish.emplace(zone.top, Pending{zone, direction, ticket});
+    else bearish.emplace(zone.bottom, Pending{zone, direction, ticket});
+    return ticket;
+}
 
-        if (confType != ConfirmationType::None) {
-            ConfirmedOB ob;
-            ob.zone = zone;
-            ob.direction = dir;
-            ob.confirmation = confType;
-            ob.confirmationDate = confDate;
-            confirmedOBs.push_back(ob);
+void OrderBlockConfirmer::addStructurePoint(const StructurePoint& point, std::vector<ConfirmedOB>& out,
+                                            std::vector<size_t>* tickets) {
+    ConfirmationType confirmation;
+    if (point.type == StructureType::CHoCH) confirmation = ConfirmationType::CHoCH;
+    else if (point.type == StructureType::BOS) confirmation = ConfirmationType::BOS;
+    else return;
+    if (point.index == 0) return;
+
+    auto confirm = [&](Pending& pending) {
+        if (pending.zone.timestamp >= point.timestamp) {
+            deferred.push_back(std::move(pending));
+            return;
         }
-    }
+        ConfirmedOB ob;
+        ob.zone = pending.zone;
+        ob.direction = std::move(pending.direction);
+        ob.confirmation = confirmation;
+        ob.confirmationTimestamp = point.timestamp;
+        out.push_back(std::move(ob));
+        if (tickets) tickets->push_back(pending.ticket);
+    };
+
+    // Bullish zones with top < price sit at the front, bearish ones with bottom > price at the back
+    deferred.clear();
+    auto firstKept = bullish.lower_bound(point.price);
+    for (auto it = bullish.begin(); it != firstKept; ++it) confirm(it->second);
+    bullish.erase(bullish.begin(), firstKept);
+    for (auto& pending : deferred) bullish.emplace(pending.zone.top, std::move(pending));
+
+    deferred.clear();
+    auto firstGone = bearish.upper_bound(point.price);
+    for (auto it = firstGone; it != bearish.end(); ++it) confirm(it->second);
+    bearish.erase(firstGone, bearish.end());
+    for (auto& pending : deferred) bearish.emplace(pending.zone.bottom, std::move(pending));
+}
 
-    return confirmedOBs;
+void OrderBlockConfirmer::reset() {
+    bullish.clear();
+    bearish.clear();
+    deferred.clear();
+    nextTicket = 0;
 }
 
 // ==============================
@@ -180,7 +317,7 @@ void OrderBlock::updateStrength(const std::vector<StructureEvent>& events, doubl
     }
 
     for (const auto& event : events) {
-        if (event.date <= date) continue;
+        if (event.timestamp <= timestamp) continue;
 
         // Scoring logic
         if (isBullishOB) {
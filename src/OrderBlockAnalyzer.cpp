@@ -1,81 +1,221 @@
 #include "OrderBlockAnalyzer.h"
 #include "TradingUtils.h"
-#include "StructureUtils.h"
 #include "LoggingUtils.h"
 #include <spdlog/spdlog.h>
+#include "Utils.h"
 #include <algorithm>
 
-OrderBlockAnalyzer::OrderBlockAnalyzer(const Config &config)
-    : reader(config.csv_path, config.data_source, config.api_endpoint, config.api_key),
-      lastOrderBlockDate(""),
-      lastCHoCHDate("")
+OrderBlockAnalyzer::OrderBlockAnalyzer(const Config &config, std::shared_ptr<spdlog::logger> logger)
+    : reader(config.csv_path, config.data_source, config.api_endpoint, config.api_key, config.csv_reader,
+             config.api_cache_dir),
+      log(logger ? std::move(logger) : spdlog::default_logger()),
+      trendlinePairSpan(static_cast<size_t>(config.trendline_pair_span)),
+      incremental(config.analysis_mode == "incremental"),
+      structure(2, 0.02, 0.02, trendlinePairSpan),
+      liveATR(14),
+      pipeline(DetectionPipeline::standard(2, 0.02, 0.02, trendlinePairSpan, 14))
 {
+    reader.setLogger(log.get());
 }
 
 void OrderBlockAnalyzer::analyze()
 {
-    auto candles = reader.readData();
+    if (incremental)
+    {
+        ingestNewBars();
+        report(structure.getCandles(), structure.getOrderBlocks(), structure.getStructureEvents());
+        updateZoneBook(structure.getCandles());
+        return;
+    }
+
+    const CandleSeries &candles = loadHistory();
+
+    // Swing points, BOS, CHoCH, trendline breaks, order blocks, entry and ATR in two passes
+    PipelineResult result = pipeline.run(candles);
+    recentSwingPoints = std::move(result.swingPoints);
+
+    report(candles, result.orderBlocks, result.structureEvents, &result);
+    updateZoneBook(candles);
+}
+
+const std::vector<StructurePoint> &OrderBlockAnalyzer::getSwingPoints() const
+{
+    return incremental ? structure.getSwingPoints() : recentSwingPoints;
+}
+
+const CandleSeries &OrderBlockAnalyzer::loadHistory()
+{
+    if (!reader.followsTail())
+    {
+        history = reader.readSeries();
+        return history;
+    }
+
+    bool replaced = false;
+    const std::vector<Candle> fresh = reader.readNewData(replaced);
+    if (replaced)
+    {
+        history.clear();
+    }
+    for (const auto &candle : fresh)
+    {
+        history.push_back(candle);
+    }
+    return history;
+}
+
+void OrderBlockAnalyzer::ingestNewBars()
+{
+    if (reader.followsTail())
+    {
+        bool replaced = false;
+        const std::vector<Candle> fresh = reader.readNewData(replaced);
+        if (replaced && structure.size() > 0)
+        {
+            log->info("Data file was replaced; rebuilding incremental state.");
+            resetIncrementalState();
+        }
+        for (const auto &candle : fresh)
+        {
+            appendBar(candle);
+        }
+        return;
+    }
+
+    const std::vector<Candle> data = reader.readData();
+    const CandleSeries &known = structure.getCandles();
+    size_t start = known.size();
+
+    // Only a pure append can be applied in place. A revised last bar or a
+    // rewritten/rotated source rebuilds the state from the full history.
+    auto sameBar = [&](size_t i)
+    {
+        const Candle &c = data[i];
+        return c.timestamp == known.timestamp[i] && c.open == known.open[i] && c.high == known.high[i] &&
+               c.low == known.low[i] && c.close == known.close[i] && c.volume == known.volume[i];
+    };
+    if (start > 0 && (data.size() < start || !sameBar(0) || !sameBar(start - 1)))
+    {
+        log->info("Data history changed; rebuilding incremental state.");
+        resetIncrementalState();
+        start = 0;
+    }
 
+    for (size_t i = start; i < data.size(); ++i)
+    {
+        appendBar(data[i]);
+    }
+}
+
+void OrderBlockAnalyzer::appendBar(const Candle &candle)
+{
+    structure.append(candle);
+    liveATR.push(candle.high, candle.low, candle.close);
+}
+
+void OrderBlockAnalyzer::resetIncrementalState()
+{
+    structure.reset();
+    liveATR.reset();
+}
+
+void OrderBlockAnalyzer::updateZoneBook(const CandleSeries &candles)
+{
+    size_t start = zoneBook.barCount();
+    if (start > candles.size() ||
+        (start > 0 && (candles.timestamp[start - 1] != zoneBookLastTime || candles.close[start - 1] != zoneBookLastClose)))
+    {
+        zoneBook.reset();
+        start = 0;
+    }
+    if (start == candles.size())
+    {
+        return;
+    }
+
+    size_t added = 0, mitigated = 0, invalidated = 0;
+    for (size_t i = start; i < candles.size(); ++i)
+    {
+        zoneBook.update(candles, i);
+        for (const auto &change : zoneBook.lastChanges())
+        {
+            if (change.zone.state == ZoneState::Fresh)
+                ++added;
+            else if (change.zone.state == ZoneState::Mitigated)
+                ++mitigated;
+            else if (change.zone.state == ZoneState::Invalidated)
+                ++invalidated;
+        }
+    }
+    zoneBookLastTime = candles.timestamp.back();
+    zoneBookLastClose = candles.close.back();
+
+    log->info(" Zone book: {} live ({} fresh, {} touched); {} new, {} mitigated, {} invalidated since last cycle.",
+              zoneBook.size(), zoneBook.freshCount(), zoneBook.touchedCount(), added, mitigated, invalidated);
+
+    std::vector<BookZone> tradable;
+    zoneBook.tradableAt(candles.close.back(), tradable);
+    for (const auto &entry : tradable)
+    {
+        log->info("   Price inside {} zone [{:.2f} - {:.2f}] formed {} ({}, {} touches)",
+                  entry.zone.type == OBType::Bullish ? "Bullish" : "Bearish", entry.zone.bottom, entry.zone.top,
+                  Utils::formatTimestamp(entry.zone.timestamp), ZoneBook::stateName(entry.state), entry.touches);
+    }
+}
+
+void OrderBlockAnalyzer::report(const CandleSeries &candles,
+                                const std::vector<std::pair<OBZone, std::string>> &orderBlocks,
+                                const std::vector<StructureEvent> &structureEvents,
+                                const PipelineResult *fused)
+{
     if (candles.size() < 50)
     {
-        spdlog::error("Not enough data (less than 50 bars available).");
+        log->error("Not enough data (less than 50 bars available).");
         return;
     }
 
     // Log latest candle with volume delta instead of structure update
-    const Candle &latestCandle = candles.back();
-    const Candle *prevCandle = (candles.size() > 1) ? &candles[candles.size() - 2] : nullptr;
+    const Candle latestCandle = candles.at(candles.size() - 1);
 
-    spdlog::info(" Latest Candle:");
-    if (prevCandle)
+    log->info(" Latest Candle:");
+    if (candles.size() > 1)
     {
-        double deltaVol = latestCandle.volume - prevCandle->volume;
-        spdlog::info(" Date: {}, O: {:.2f}, H: {:.2f}, L: {:.2f}, C: {:.2f}, Vol: {}, ΔVol: {}",
-                     latestCandle.date, latestCandle.open, latestCandle.high, latestCandle.low, latestCandle.close,
+        double deltaVol = latestCandle.volume - candles.volume[candles.size() - 2];
+        log->info(" Date: {}, O: {:.2f}, H: {:.2f}, L: {:.2f}, C: {:.2f}, Vol: {}, ΔVol: {}",
+                     Utils::formatTimestamp(latestCandle.timestamp), latestCandle.open, latestCandle.high, latestCandle.low, latestCandle.close,
                      latestCandle.volume, deltaVol);
     }
     else
     {
-        spdlog::info(" Date: {}, O: {:.2f}, H: {:.2f}, L: {:.2f}, C: {:.2f}, Vol: {}",
-                     latestCandle.date, latestCandle.open, latestCandle.high, latestCandle.low, latestCandle.close,
+        log->info(" Date: {}, O: {:.2f}, H: {:.2f}, L: {:.2f}, C: {:.2f}, Vol: {}",
+                     Utils::formatTimestamp(latestCandle.timestamp), latestCandle.open, latestCandle.high, latestCandle.low, latestCandle.close,
                      latestCandle.volume);
     }
 
-    // Detect swing points, BOS, CHoCH, and trendline breaks as before
-    auto swingPoints = detectSwingPoints(candles);
-    auto bosPoints = detectBOS(candles, swingPoints);
-    auto chochPoints = detectCHoCH(candles, swingPoints);
-    auto trendBreaks = detectTrendlineBreak(candles, swingPoints);
-
-    // Remove structure update logging from here, as you requested
-
-    if (lastOrderBlockDate == latestCandle.date)
+    if (lastOrderBlockTime == latestCandle.timestamp)
     {
-        spdlog::info("No new order block detected for today.");
+        log->info("No new order block detected for today.");
         return;
     }
 
-    auto structureEvents = StructureUtils::gatherStructureEvents(bosPoints, chochPoints, trendBreaks, candles);
-
-    auto orderBlocks = detectOrderBlocks(candles);
     if (orderBlocks.empty())
     {
-        spdlog::info(" No order blocks detected.");
+        log->info(" No order blocks detected.");
         return;
     }
 
-    auto latestOrderBlock = orderBlocks.back();
-    std::string latestDate = latestOrderBlock.first.date;
+    const auto &latestOrderBlock = orderBlocks.back();
+    int64_t latestTime = latestOrderBlock.first.timestamp;
 
-    if (latestDate > lastOrderBlockDate)
+    if (latestTime > lastOrderBlockTime)
     {
-        lastOrderBlockDate = latestDate;
+        lastOrderBlockTime = latestTime;
         const OBZone &ob = latestOrderBlock.first;
         const std::string &obType = latestOrderBlock.second;
         bool isBuy = (obType == "Bullish");
 
         OrderBlock obBlock = TradingUtils::createOrderBlockFromZone(ob, obType);
-        double currentClose = candles.back().close;
+        double currentClose = latestCandle.close;
         bool isBullishOB = (obType == "Bullish");
 
         obBlock.updateStrength(structureEvents, currentClose, isBullishOB);
@@ -83,13 +223,19 @@ void OrderBlockAnalyzer::analyze()
         // Find entry price inside the OB zone after detection date
         double entryPrice = obBlock.entryPrice;
         bool foundEntry = false;
-        for (const auto &candle : candles)
+        if (fused)
+        {
+            foundEntry = fused->entryFound;
+            if (foundEntry)
+                entryPrice = fused->entryPrice;
+        }
+        for (size_t i = 0; !fused && i < candles.size(); ++i)
         {
-            if (candle.date > latestDate &&
-                candle.close >= std::min(ob.bottom, ob.top) &&
-                candle.close <= std::max(ob.bottom, ob.top))
+            if (candles.timestamp[i] > latestTime &&
+                candles.close[i] >= std::min(ob.bottom, ob.top) &&
+                candles.close[i] <= std::max(ob.bottom, ob.top))
             {
-                entryPrice = candle.close;
+                entryPrice = candles.close[i];
                 foundEntry = true;
                 break;
             }
@@ -98,20 +244,20 @@ void OrderBlockAnalyzer::analyze()
 
         if (!foundEntry)
         {
-            spdlog::warn(" No candle close found inside OB zone post-date; using boundary.");
+            log->warn(" No candle close found inside OB zone post-date; using boundary.");
         }
 
-        LoggingUtils::logOrderBlockInfo(obBlock, ob, obType, latestDate, foundEntry, entryPrice, candles);
+        LoggingUtils::logOrderBlockInfo(obBlock, ob, obType, latestTime, foundEntry, entryPrice, candles, log.get());
 
-        // Pass ATR period, e.g., 14
-        double atr = TradingUtils::calculateATR(candles, 14);
+        // ATR(14): from the pipeline in full mode, kept bar by bar in incremental mode
+        double atr = fused ? fused->atr : liveATR.value();
         if (atr > 0)
         {
-            TradingUtils::logRiskManagement(entryPrice, ob, isBuy, atr);
+            TradingUtils::logRiskManagement(entryPrice, ob, isBuy, atr, 1.5, 2.0, 1.0, log.get());
         }
         else
         {
-            spdlog::warn(" ATR calculation failed or returned 0.");
+            log->warn(" ATR calculation failed or returned 0.");
         }
     }
 }
@@ -0,0 +1,371 @@
+#include "ParameterSweep.h"
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <spdlog/spdlog.h>
+#include "Indicators.h"
+
+namespace {
+
+constexpr size_t kNone = std::numeric_limits<size_t>::max();
+
+// Structure event at bar `index`, first known at bar `knownAt`
+struct KnownEvent {
+    size_t index;
+    size_t knownAt;
+    double price;
+};
+
+// Answers "first event at or after `from` whose price is above (or below) x"
+class BeyondTree {
+public:
+    BeyondTree(const std::vector<KnownEvent>& events, bool above) : above(above) {
+        const double pad = above ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::infinity();
+        leaves = 1;
+        while (leaves < events.size()) leaves <<= 1;
+        tree.assign(2 * leaves, pad);
+        for (size_t i = 0; i < events.size(); ++i) {
+            if (!std::isnan(events[i].price)) tree[leaves + i] = events[i].price;
+        }
+        for (size_t node = leaves - 1; node > 0; --node) {
+            tree[node] = above ? std::max(tree[2 * node], tree[2 * node + 1]) : std::min(tree[2 * node], tree[2 * node + 1]);
+        }
+    }
+
+    size_t first(size_t from, double x) const { return descend(1, 0, leaves, from, x); }
+
+private:
+    bool above;
+    size_t leaves;
+    std::vector<double> tree;
+
+    bool beyond(double value, double x) const { return above ? value > x : value < x; }
+
+    size_t descend(size_t node, size_t lo, size_t hi, size_t from, double x) const {
+        if (hi <= from || !beyond(tree[node], x)) return kNone;
+        if (hi - lo == 1) return lo;
+        const size_t mid = (lo + hi) / 2;
+        const size_t left = descend(2 * node, lo, mid, from, x);
+        return left != kNone ? left : descend(2 * node + 1, mid, hi, from, x);
+    }
+};
+
+// CHoCH candles (same set as detectCHoCH). The state at bar j depends on every swing
+// before it, and the swing detector settles bar j - 1 at j - 1 + lookback.
+void chochEvents(const CandleSeries& candles, const std::vector<StructurePoint>& swings, int lookback,
+                 double retraceThreshold, std::vector<KnownEvent>& out) {
+    const size_t lag = lookback > 0 ? static_cast<size_t>(lookback) - 1 : 0;
+    CHoCHDetector detector(retraceThreshold);
+    StructurePoint point;
+    size_t next = 0;
+    for (size_t j = 1; j < candles.size(); ++j) {
+        for (; next < swings.size() && swings[next].index < j; ++next) detector.addSwing(swings[next]);
+        if (detector.push(j, candles.close[j], candles.timestamp[j], point)) out.push_back({j, j + lag, point.price});
+    }
+}
+
+// Trendline breaks, known once the pivot that completes the line is confirmed
+void trendlineEvents(const CandleSeries& candles, const std::vector<StructurePoint>& swings, int lookback,
+                     double threshold, size_t pairSpan, std::vector<KnownEvent>& out) {
+    TrendlineBreakDetector detector(threshold, pairSpan);
+    std::vector<StructurePoint> breaks;
+    for (const auto& swing : swings) {
+        const size_t first = breaks.size();
+        detector.addSwing(swing, candles, breaks);
+        for (size_t k = first; k < breaks.size(); ++k) {
+            out.push_back({breaks[k].index, swing.index + lookback, breaks[k].price});
+        }
+    }
+}
+
+} // namespace
+
+// Everything that depends on the swing lookback alone
+struct ParameterSweep::LookbackCache {
+    std::once_flag once;
+    std::vector<StructurePoint> swings;
+    std::vector<KnownEvent> bos;   // one per broken swing, as detectBOS
+};
+
+// ATR at every bar for one period
+struct ParameterSweep::ATRCache {
+    std::once_flag once;
+    std::vector<double> atr;       // Indicators::atrSeries, as the analyzer reports it
+};
+
+std::vector<SweepParams> SweepSpace::grid() const {
+    std::vector<SweepParams> configs;
+    for (int lookback : swingLookbacks)
+        for (double retrace : retraceThresholds)
+            for (double trendline : trendlineThresholds)
+                for (size_t span : trendlinePairSpans)
+                    for (size_t atrPeriod : atrPeriods)
+                        for (double risk : riskATRMultipliers)
+                            for (double reward : rewardRiskRatios)
+                                configs.push_back({lookback, retrace, trendline, span, atrPeriod, risk, reward});
+    return configs;
+}
+
+std::vector<SweepParams> SweepSpace::sample(size_t count, uint64_t seed) const {
+    std::vector<SweepParams> configs;
+    if (swingLookbacks.empty() || retraceThresholds.empty() || trendlineThresholds.empty() ||
+        trendlinePairSpans.empty() || atrPeriods.empty() || riskATRMultipliers.empty() || rewardRiskRatios.empty()) {
+        return configs;
+    }
+
+    std::mt19937_64 rng(seed);
+    auto pick = [&rng](const auto& values) {
+        return values[std::uniform_int_distribution<size_t>(0, values.size() - 1)(rng)];
+    };
+
+    configs.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        SweepParams params;
+        params.swingLookback = pick(swingLookbacks);
+        params.retraceThreshold = pick(retraceThresholds);
+        params.trendlineThreshold = pick(trendlineThresholds);
+        params.trendlinePairSpan = pick(trendlinePairSpans);
+        params.atrPeriod = pick(atrPeriods);
+        params.riskATRMultiplier = pick(riskATRMultipliers);
+        params.rewardRiskRatio = pick(rewardRiskRatios);
+        configs.push_back(params);
+    }
+    return configs;
+}
+
+ParameterSweep::ParameterSweep(const CandleSeries& candles, const BacktestConfig& backtestConfig)
+    : candles(candles), backtestConfig(backtestConfig), orderBlocks(detectOrderBlocks(candles)) {
+    // Orders are placed on the bar their signal is known, so no extra confirmation delay
+    this->backtestConfig.confirmationBars = 0;
+    this->backtestConfig.atrPeriod = 0;  // stops come from atrFor instead
+
+    orderBlockIndex.reserve(orderBlocks.size());
+    for (const auto& ob : orderBlocks) {
+        auto it = std::lower_bound(candles.timestamp.begin(), candles.timestamp.end(), ob.first.timestamp);
+        orderBlockIndex.push_back(static_cast<size_t>(it - candles.timestamp.begin()));
+    }
+}
+
+ParameterSweep::~ParameterSweep() = default;
+
+const std::vector<double>& ParameterSweep::atrFor(size_t period) const {
+    ATRCache* cache;
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        auto& slot = atrCaches[period];
+        if (!slot) slot = std::make_unique<ATRCache>();
+        cache = slot.get();
+    }
+
+    std::call_once(cache->once, [&] { cache->atr = Indicators::atrSeries(candles, period); });
+    return cache->atr;
+}
+
+const ParameterSweep::LookbackCache& ParameterSweep::cacheFor(int lookback) const {
+    LookbackCache* cache;
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        auto& slot = caches[lookback];
+        if (!slot) slot = std::make_unique<LookbackCache>();
+        cache = slot.get();
+    }
+
+    // The first configuration with this lookback computes it; the rest wait and reuse it
+    std::call_once(cache->once, [&] {
+        cache->swings = detectSwingPoints(candles, lookback);
+
+        for (const KnownBOS& bos : bosKnownBars(candles, cache->swings, lookback)) {
+            cache->bos.push_back({bos.bar, bos.knownAt, candles.close[bos.bar]});
+        }
+    });
+    return *cache;
+}
+
+std::vector<Order> ParameterSweep::ordersFor(const SweepParams& params) const {
+    const LookbackCache& cache = cacheFor(params.swingLookback);
+
+    std::vector<KnownEvent> events = cache.bos;
+    chochEvents(candles, cache.swings, params.swingLookback, params.retraceThreshold, events);
+    trendlineEvents(candles, cache.swings, params.swingLookback, params.trendlineThreshold, params.trendlinePairSpan,
+                    events);
+    std::stable_sort(events.begin(), events.end(),
+                     [](const KnownEvent& a, const KnownEvent& b) { return a.index < b.index; });
+
+    const BeyondTree aboveTree(events, true);
+    const BeyondTree belowTree(events, false);
+    const size_t n = candles.size();
+    const std::vector<double>& atrByBar = atrFor(params.atrPeriod);
+
+    std::vector<Order> orders;
+    for (size_t k = 0; k < orderBlocks.size(); ++k) {
+        const OBZone& zone = orderBlocks[k].first;
+        const bool isBuy = zone.type == OBType::Bullish;
+        const size_t obBar = orderBlockIndex[k];
+
+        // First event after the OB candle that closes beyond the zone
+        auto after = std::upper_bound(events.begin(), events.end(), obBar,
+                                      [](size_t bar, const KnownEvent& e) { return bar < e.index; });
+        const size_t from = static_cast<size_t>(after - events.begin());
+        const size_t hit = isBuy ? aboveTree.first(from, zone.top) : belowTree.first(from, zone.bottom);
+        if (hit == kNone) continue;
+
+        const size_t placedAt = std::max(events[hit].knownAt, obBar + 2);
+        if (placedAt + 1 >= n) continue;
+
+        const double atr = atrByBar[placedAt];
+        if (!(atr > 0)) continue;
+
+        const double risk = atr * params.riskATRMultiplier;
+        const int64_t timestamp = candles.timestamp[placedAt];
+        if (isBuy) {
+            orders.emplace_back(Order::Type::BUY, zone.top, timestamp, zone.top - risk, zone.top + risk * params.rewardRiskRatio);
+        } else {
+            orders.emplace_back(Order::Type::SELL, zone.bottom, timestamp, zone.bottom + risk, zone.bottom - risk * params.rewardRiskRatio);
+        }
+    }
+    return orders;
+}
+
+SweepResult ParameterSweep::evaluate(const SweepParams& params) const {
+    const BacktestResult backtest = Backtest(backtestConfig).run(candles, ordersFor(params));
+
+    SweepResult result;
+    result.params = params;
+    result.trades = backtest.trades.size();
+    result.wins = backtest.wins;
+    result.netProfit = backtest.finalEquity - backtestConfig.initialCapital;
+    result.maxDrawdown = backtest.maxDrawdown;
+
+    double grossProfit = 0.0, grossLoss = 0.0;
+    for (const auto& trade : backtest.trades) {
+        if (trade.pnl > 0) grossProfit += trade.pnl;
+        else grossLoss -= trade.pnl;
+    }
+    result.profitFactor = grossLoss > 0 ? grossProfit / grossLoss
+                                        : (grossProfit > 0 ? std::numeric_limits<double>::infinity() : 0.0);
+    return result;
+}
+
+std::vector<SweepResult> ParameterSweep::run(const std::vector<SweepParams>& configs, size_t threads) const {
+    std::vector<SweepResult> results(configs.size());
+    if (configs.empty()) return results;
+
+    // Configurations sharing a lookback sit next to each other, so a worker mostly reuses one cache
+    std::vector<size_t> jobs(configs.size());
+    std::iota(jobs.begin(), jobs.end(), 0);
+    std::stable_sort(jobs.begin(), jobs.end(), [&](size_t a, size_t b) {
+        return configs[a].swingLookback < configs[b].swingLookback;
+    });
+
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min(threads, jobs.size());
+
+    // Work stealing: each worker owns a contiguous slice of the job list and takes from its
+    // front; an idle worker steals the back half of the largest remaining slice.
+    struct Slice {
+        std::mutex mutex;
+        size_t begin = 0;
+        size_t end = 0;
+    };
+    std::vector<Slice> slices(threads);
+    for (size_t w = 0; w < threads; ++w) {
+        slices[w].begin = jobs.size() * w / threads;
+        slices[w].end = jobs.size() * (w + 1) / threads;
+    }
+
+    auto steal = [&](size_t thief) {
+        for (;;) {
+            size_t victim = kNone, largest = 0;
+            for (size_t v = 0; v < threads; ++v) {
+                if (v == thief) continue;
+                std::lock_guard<std::mutex> lock(slices[v].mutex);
+                if (slices[v].end - slices[v].begin > largest) {
+                    largest = slices[v].end - slices[v].begin;
+                    victim = v;
+                }
+            }
+            if (victim == kNone) return false;
+
+            size_t begin, end;
+            {
+                std::lock_guard<std::mutex> lock(slices[victim].mutex);
+                const size_t remaining = slices[victim].end - slices[victim].begin;
+                if (remaining == 0) continue;  // drained meanwhile; look again
+                end = slices[victim].end;
+                begin = end - (remaining + 1) / 2;
+                slices[victim].end = begin;
+            }
+            std::lock_guard<std::mutex> lock(slices[thief].mutex);
+            slices[thief].begin = begin;
+            slices[thief].end = end;
+            return true;
+        }
+    };
+
+    std::mutex errorMutex;
+    std::exception_ptr firstError;
+
+    auto worker = [&](size_t w) {
+        for (;;) {
+            size_t job = kNone;
+            {
+                std::lock_guard<std::mutex> lock(slices[w].mutex);
+                if (slices[w].begin < slices[w].end) job = slices[w].begin++;
+            }
+            if (job == kNone) {
+                if (!steal(w)) return;
+                continue;
+            }
+
+            try {
+                results[jobs[job]] = evaluate(configs[jobs[job]]);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!firstError) firstError = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (size_t w = 1; w < threads; ++w) workers.emplace_back(worker, w);
+    worker(0);
+    for (auto& t : workers) t.join();
+
+    if (firstError) std::rethrow_exception(firstError);
+
+    std::stable_sort(results.begin(), results.end(), [](const SweepResult& a, const SweepResult& b) {
+        if (a.netProfit != b.netProfit) return a.netProfit > b.netProfit;
+        return a.maxDrawdown < b.maxDrawdown;
+    });
+    return results;
+}
+
+bool ParameterSweep::writeTable(const std::string& path, const std::vector<SweepResult>& results) {
+    std::ofstream out(path);
+    if (!out.is_open()) {
+        spdlog::error("Error opening file for writing: {}", path);
+        return false;
+    }
+
+    out << "rank,swing_lookback,retrace_threshold,trendline_threshold,trendline_pair_span,atr_period,risk_atr_multiplier,"
+           "reward_risk_ratio,trades,win_rate,net_profit,max_drawdown,profit_factor\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const SweepResult& r = results[i];
+        const double winRate = r.trades ? static_cast<double>(r.wins) / static_cast<double>(r.trades) : 0.0;
+        out << i + 1 << ',' << r.params.swingLookback << ',' << r.params.retraceThreshold << ','
+            << r.params.trendlineThreshold << ',' << r.params.trendlinePairSpan << ',' << r.params.atrPeriod << ',' << r.params.riskATRMultiplier << ','
+            << r.params.rewardRiskRatio << ',' << r.trades << ',' << winRate << ',' << r.netProfit << ','
+            << r.maxDrawdown << ',' << r.profitFactor << '\n';
+    }
+    if (!out) {
+        spdlog::error("Error writing file: {}", path);
+        return false;
+    }
+    return true;
+}
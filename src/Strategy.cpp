@@ -1,16 +1,51 @@
 #include "Strategy.h"
-#include <iostream>
 #include <algorithm>
+#include <limits>
+#include <spdlog/spdlog.h>
 #include "Order.h"
+#include "Utils.h"
 
-// Constructor: Accepts candles and structure points (CHoCH, BOS)
-Strategy::Strategy(const std::vector<Candle>& candles, const std::vector<StructurePoint>& choch, const std::vector<StructurePoint>& bos)
-    : candles(candles), choch(choch), bos(bos) {}
+namespace {
+
+namespace col = CandleColumns;
+
+constexpr size_t kNever = std::numeric_limits<size_t>::max();
+
+// Index of the first bar at or after `timestamp`
+template <typename Series>
+size_t barAt(const Series& candles, int64_t timestamp) {
+    size_t lo = 0, hi = col::size(candles);
+    while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        if (col::timestamp(candles, mid) < timestamp) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+} // namespace
+
+// Constructor: Borrows candles, swing points and structure points (CHoCH, BOS)
+Strategy::Strategy(const std::vector<Candle>& candles, const std::vector<StructurePoint>& swings,
+                   const std::vector<StructurePoint>& choch, const std::vector<StructurePoint>& bos,
+                   int swingLookback, spdlog::logger* log)
+    : candles(&candles), swings(&swings), choch(&choch), bos(&bos), swingLookback(swingLookback),
+      log(log ? log : spdlog::default_logger_raw()) {}
+
+Strategy::Strategy(const CandleSeries& candles, const std::vector<StructurePoint>& swings,
+                   const std::vector<StructurePoint>& choch, const std::vector<StructurePoint>& bos,
+                   int swingLookback, spdlog::logger* log)
+    : series(&candles), swings(&swings), choch(&choch), bos(&bos), swingLookback(swingLookback),
+      log(log ? log : spdlog::default_logger_raw()) {}
 
 // Main strategy runner
 void Strategy::run() {
-    detectAndGenerateOrders();
-    confirmAndFilterOrderBlocks();
+    orders.clear();
+    if (series) {
+        detectConfirmAndGenerate(*series);
+    } else {
+        detectConfirmAndGenerate(*candles);
+    }
 }
 
 // Method to get generated orders
@@ -18,69 +53,87 @@ const std::vector<Order>& Strategy::getOrders() const {
     return orders;
 }
 
-// Detect order blocks and generate orders
-void Strategy::detectAndGenerateOrders() {
+// Detect order blocks once, confirm them with structure points (CHoCH, BOS) and
+// generate orders for the confirmed ones
+template <typename Series>
+void Strategy::detectConfirmAndGenerate(const Series& candles) {
     // Detect both bullish and bearish order blocks
     auto rawOrderBlocks = detectOrderBlocks(candles);
-    
+
     for (const auto& ob : rawOrderBlocks) {
         const OBZone& zone = ob.first;
-        const std::string& direction = ob.second;
 
         // Log detected order block
-        std::cout << "Detected Order Block: " << direction << " at " << zone.date 
-                  << " | Zone Top: " << zone.top << " | Zone Bottom: " << zone.bottom << std::endl;
+        log->info("Detected Order Block: {} at {} | Zone Top: {} | Zone Bottom: {}",
+                  ob.second, Utils::formatTimestamp(zone.timestamp), zone.top, zone.bottom);
+    }
+
+    std::vector<ConfirmedOB> confirmedOrderBlocks = filterOrderBlocksWithStructure(candles, rawOrderBlocks, *choch, *bos);
+
+    // The batch detectors see every bar; an order may only act once its confirmation is detectable
+    const size_t n = col::size(candles);
+    const std::vector<size_t> bosKnown = bosKnownAt(candles);
+    const size_t chochLag = swingLookback > 0 ? static_cast<size_t>(swingLookback) - 1 : 0;
+
+    for (const auto& confirmedOB : confirmedOrderBlocks) {
+        // Log confirmed order block
+        log->info("Confirmed {} OB at {} with confirmation on {}",
+                  confirmedOB.zone.type == OBType::Bullish ? "Bullish" : "Bearish", confirmedOB.zone.top,
+                  Utils::formatTimestamp(confirmedOB.confirmationTimestamp));
+
+        const size_t bar = barAt(candles, confirmedOB.confirmationTimestamp);
+        const size_t knownAt = confirmedOB.confirmation == ConfirmationType::CHoCH ? bar + chochLag : bosKnown[bar];
+        if (knownAt >= n) {
+            log->info("Confirmation not known by the last bar; no order yet");
+            continue;
+        }
+        const int64_t activation = col::timestamp(candles, knownAt);
 
         // Generate the order based on the order block's direction
-        if (direction == "Bullish") {
-            generateBuyOrder(zone);
-        } else if (direction == "Bearish") {
-            generateSellOrder(zone);
+        if (confirmedOB.direction == "Bullish") {
+            generateBuyOrder(confirmedOB.zone, activation);
+        } else if (confirmedOB.direction == "Bearish") {
+            generateSellOrder(confirmedOB.zone, activation);
         }
     }
 }
 
+// Earliest bar at which the BOS on each bar is known (kNever for bars without one)
+template <typename Series>
+std::vector<size_t> Strategy::bosKnownAt(const Series& candles) const {
+    std::vector<size_t> known(col::size(candles), kNever);
+    for (const KnownBOS& bos : bosKnownBars(candles, *swings, swingLookback)) {
+        known[bos.bar] = std::min(known[bos.bar], bos.knownAt);
+    }
+    return known;
+}
+
 // Generate a buy order for bullish order blocks
-void Strategy::generateBuyOrder(const OBZone& ob) {
+void Strategy::generateBuyOrder(const OBZone& ob, int64_t activationTimestamp) {
     // Example: Buy at the close of the confirmed OB
     double takeProfit = ob.top + (ob.top - ob.bottom) * 2;  // Example TP (you can adjust this formula)
     double stopLoss = ob.bottom;  // Example SL (you can adjust this)
 
     // Create buy order and push it into the orders vector
-    Order order(Order::Type::BUY, ob.top, ob.date, stopLoss, takeProfit);
+    Order order(Order::Type::BUY, ob.top, ob.timestamp, stopLoss, takeProfit, activationTimestamp);
     orders.push_back(order);
 
     // Log the order generation
-    std::cout << "Generated Buy Order at " << ob.top << " on " << ob.date << " | Stop Loss: " 
-              << stopLoss << " | Take Profit: " << takeProfit << std::endl;
+    log->info("Generated Buy Order at {} on {} (active after {}) | Stop Loss: {} | Take Profit: {}",
+              ob.top, Utils::formatTimestamp(ob.timestamp), Utils::formatTimestamp(activationTimestamp), stopLoss, takeProfit);
 }
 
 // Generate a sell order for bearish order blocks
-void Strategy::generateSellOrder(const OBZone& ob) {
+void Strategy::generateSellOrder(const OBZone& ob, int64_t activationTimestamp) {
     // Example: Sell at the close of the confirmed OB
     double takeProfit = ob.bottom - (ob.top - ob.bottom) * 2;  // Example TP (you can adjust this formula)
     double stopLoss = ob.top;  // Example SL (you can adjust this)
 
     // Create sell order and push it into the orders vector
-    Order order(Order::Type::SELL, ob.bottom, ob.date, stopLoss, takeProfit);
+    Order order(Order::Type::SELL, ob.bottom, ob.timestamp, stopLoss, takeProfit, activationTimestamp);
     orders.push_back(order);
 
     // Log the order generation
-    std::cout << "Generated Sell Order at " << ob.bottom << " on " << ob.date << " | Stop Loss: " 
-              << stopLoss << " | Take Profit: " << takeProfit << std::endl;
-}
-
-// Filter and confirm order blocks with structure points (CHoCH, BOS)
-void Strategy::confirmAndFilterOrderBlocks() {
-    // Use structure points (CHoCH, BOS) to validate and filter order blocks
-    std::vector<ConfirmedOB> confirmedOrderBlocks = filterOrderBlocksWithStructure(
-        candles, detectOrderBlocks(candles), choch, bos
-    );
-
-    // Log confirmed order blocks
-    for (const auto& confirmedOB : confirmedOrderBlocks) {
-        std::cout << "Confirmed " << (confirmedOB.zone.type == OBType::Bullish ? "Bullish" : "Bearish")
-                  << " OB at " << confirmedOB.zone.top << " with confirmation on " 
-                  << confirmedOB.confirmationDate << std::endl;
-    }
+    log->info("Generated Sell Order at {} on {} (active after {}) | Stop Loss: {} | Take Profit: {}",
+              ob.bottom, Utils::formatTimestamp(ob.timestamp), Utils::formatTimestamp(activationTimestamp), stopLoss, takeProfit);
 }
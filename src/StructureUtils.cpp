@@ -1,40 +1,63 @@
 #include "StructureUtils.h"
 #include <OrderBlock.h>
 
-std::vector<StructureEvent> StructureUtils::gatherStructureEvents(
-    const std::vector<StructurePoint> &bosPoints,
-    const std::vector<StructurePoint> &chochPoints,
-    const std::vector<StructurePoint> &trendBreaks,
-    const std::vector<Candle> &candles)
+namespace
 {
-    std::vector<StructureEvent> structureEvents;
+    namespace col = CandleColumns;
 
-    for (const auto &bos : bosPoints)
+    template <typename Series>
+    std::vector<StructureEvent> gatherImpl(
+        const std::vector<StructurePoint> &bosPoints,
+        const std::vector<StructurePoint> &chochPoints,
+        const std::vector<StructurePoint> &trendBreaks,
+        const Series &candles)
     {
-        if (bos.type != StructureType::BOS) continue;
-        if (bos.index < candles.size())
+        std::vector<StructureEvent> structureEvents;
+        structureEvents.reserve(bosPoints.size() + chochPoints.size() + trendBreaks.size());
+
+        for (const auto &bos : bosPoints)
         {
-            const Candle &candle = candles[bos.index];
-            bool isBullish = candle.close > candle.open;
-            structureEvents.emplace_back(isBullish ? StructureEventType::BOS_Bullish : StructureEventType::BOS_Bearish, bos.date, bos.price);
+            if (bos.type != StructureType::BOS) continue;
+            if (bos.index < col::size(candles))
+            {
+                bool isBullish = col::isBullish(candles, bos.index);
+                structureEvents.emplace_back(isBullish ? StructureEventType::BOS_Bullish : StructureEventType::BOS_Bearish, bos.timestamp, bos.price);
+            }
         }
-    }
 
-    for (const auto &choch : chochPoints)
-    {
-        if (choch.type != StructureType::CHoCH) continue;
-        if (choch.index < candles.size())
+        for (const auto &choch : chochPoints)
         {
-            const Candle &candle = candles[choch.index];
-            bool isBullish = candle.close > candle.open;
-            structureEvents.emplace_back(isBullish ? StructureEventType::CHoCH_Bullish : StructureEventType::CHoCH_Bearish, choch.date, choch.price);
+            if (choch.type != StructureType::CHoCH) continue;
+            if (choch.index < col::size(candles))
+            {
+                bool isBullish = col::isBullish(candles, choch.index);
+                structureEvents.emplace_back(isBullish ? StructureEventType::CHoCH_Bullish : StructureEventType::CHoCH_Bearish, choch.timestamp, choch.price);
+            }
         }
-    }
 
-    for (const auto &tb : trendBreaks)
-    {
-        structureEvents.emplace_back(StructureEventType::TrendlineBreak, tb.date, tb.price);
+        for (const auto &tb : trendBreaks)
+        {
+            structureEvents.emplace_back(StructureEventType::TrendlineBreak, tb.timestamp, tb.price);
+        }
+
+        return structureEvents;
     }
+}
 
-    return structureEvents;
+std::vector<StructureEvent> StructureUtils::gatherStructureEvents(
+    const std::vector<StructurePoint> &bosPoints,
+    const std::vector<StructurePoint> &chochPoints,
+    const std::vector<StructurePoint> &trendBreaks,
+    const std::vector<Candle> &candles)
+{
+    return gatherImpl(bosPoints, chochPoints, trendBreaks, candles);
+}
+
+std::vector<StructureEvent> StructureUtils::gatherStructureEvents(
+    const std::vector<StructurePoint> &bosPoints,
+    const std::vector<StructurePoint> &chochPoints,
+    const std::vector<StructurePoint> &trendBreaks,
+    const CandleSeries &candles)
+{
+    return gatherImpl(bosPoints, chochPoints, trendBreaks, candles);
 }
@@ -4,6 +4,7 @@
 #include <iomanip>
 #include <cmath>
 #include <stdexcept>
+#include <algorithm>
 
 namespace TradingUtils
 {
@@ -39,21 +40,56 @@ namespace TradingUtils
             return "sideways";
     }
 
+    namespace
+    {
+        namespace col = CandleColumns;
+
+        template <typename Series>
+        std::string trendFromCloses(const Series &candles)
+        {
+            const size_t n = col::size(candles);
+            if (n < 2)
+                return "undefined";
+
+            double lastClose = col::close(candles, n - 1);
+            double prevClose = col::close(candles, n - 2);
+
+            if (lastClose > prevClose)
+                return "uptrend";
+            else if (lastClose < prevClose)
+                return "downtrend";
+            else
+                return "sideways";
+        }
+
+        // Mean true range over the last `period` bars; written over raw column
+        // pointers so the loop vectorizes on the columnar layout
+        double meanTrueRange(const double *high, const double *low, const double *prevClose, size_t count)
+        {
+            double atrSum = 0.0;
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                double tr1 = high[i] - low[i];
+                double tr2 = std::fabs(high[i] - prevClose[i]);
+                double tr3 = std::fabs(low[i] - prevClose[i]);
+
+                atrSum += std::max({tr1, tr2, tr3});
+            }
+
+            return atrSum / static_cast<double>(count);
+        }
+    }
+
     // New overload: trend from Candles
     std::string getTrendDirection(const std::vector<Candle> &candles)
     {
-        if (candles.size() < 2)
-            return "undefined";
-
-        double lastClose = candles.back().close;
-        double prevClose = candles[candles.size() - 2].close;
+        return trendFromCloses(candles);
+    }
 
-        if (lastClose > prevClose)
-            return "uptrend";
-        else if (lastClose < prevClose)
-            return "downtrend";
-        else
-            return "sideways";
+    std::string getTrendDirection(const CandleSeries &candles)
+    {
+        return trendFromCloses(candles);
     }
 
     double calculateATR(const std::vector<Candle> &candles, size_t period)
@@ -80,22 +116,30 @@ namespace TradingUtils
         return atrSum / static_cast<double>(period);
     }
 
+    double calculateATR(const CandleSeries &candles, size_t period)
+    {
+        if (candles.size() < period + 1)
+            return 0.0;
+
+        const size_t first = candles.size() - period;
+        return meanTrueRange(candles.high.data() + first, candles.low.data() + first,
+                             candles.close.data() + first - 1, period);
+    }
+
     void logRiskManagement(double entryPrice, const OBZone &orderBlock, bool isBuy, double atr,
-                           double riskATRMultiplier, double rewardRiskRatioTP2, double rewardRiskRatioTP1)
+                           double riskATRMultiplier, double rewardRiskRatioTP2, double rewardRiskRatioTP1,
+                           spdlog::logger *log)
     {
         double risk = atr * riskATRMultiplier;
         double sl = isBuy ? entryPrice - risk : entryPrice + risk;
         double tp1 = isBuy ? entryPrice + risk * rewardRiskRatioTP1 : entryPrice - risk * rewardRiskRatioTP1;
         double tp2 = isBuy ? entryPrice + risk * rewardRiskRatioTP2 : entryPrice - risk * rewardRiskRatioTP2;
 
-        std::cout << std::fixed << std::setprecision(4);
-        std::cout << "[RiskManagement] Entry: " << entryPrice
-                  << (isBuy ? " BUY " : " SELL ")
-                  << ", ATR: " << atr
-                  << ", SL: " << sl
-                  << ", TP1: " << tp1
-                  << ", TP2: " << tp2
-                  << std::endl;
+        // Through the logger, so lines from concurrently analyzed symbols stay whole and tagged
+        if (!log)
+            log = spdlog::default_logger_raw();
+        log->info("[RiskManagement] Entry: {:.4f}{}, ATR: {:.4f}, SL: {:.4f}, TP1: {:.4f}, TP2: {:.4f}",
+                  entryPrice, isBuy ? " BUY " : " SELL ", atr, sl, tp1, tp2);
     }
 
     OrderBlock createOrderBlockFromZone(const OBZone &obZone, const std::string &typeStr)
@@ -110,24 +154,27 @@ namespace TradingUtils
 
         double entryPrice = (obZone.top + obZone.bottom) / 2.0;
 
-        OrderBlock ob(obZone.date, obZone.top, obZone.bottom, entryPrice, obType);
+        OrderBlock ob(obZone.timestamp, obZone.top, obZone.bottom, entryPrice, obType);
 
         return ob;
     }
 
-    void logCandleWithDelta(const Candle &curr, const Candle *prev)
+    void logCandleWithDelta(const Candle &curr, const Candle *prev, spdlog::logger *log)
     {
+        if (!log)
+            log = spdlog::default_logger_raw();
+
         if (prev)
         {
             double delta = curr.volume - prev->volume;
-            spdlog::info("Candle[Date:{}, O:{}, H:{}, L:{}, C:{}, Vol:{}, ΔVol:{}]",
-                         curr.date, curr.open, curr.high, curr.low, curr.close,
+            log->info("Candle[Date:{}, O:{}, H:{}, L:{}, C:{}, Vol:{}, ΔVol:{}]",
+                         Utils::formatTimestamp(curr.timestamp), curr.open, curr.high, curr.low, curr.close,
                          curr.volume, delta);
         }
         else
         {
-            spdlog::info("Candle[Date:{}, O:{}, H:{}, L:{}, C:{}, Vol:{}]",
-                         curr.date, curr.open, curr.high, curr.low, curr.close, curr.volume);
+            log->info("Candle[Date:{}, O:{}, H:{}, L:{}, C:{}, Vol:{}]",
+                         Utils::formatTimestamp(curr.timestamp), curr.open, curr.high, curr.low, curr.close, curr.volume);
         }
     }
 
@@ -0,0 +1,130 @@
+#include "Utils.h"
+#include <cctype>
+#include <cstdio>
+
+namespace Utils
+{
+    namespace
+    {
+        // Read exactly `width` digits at `pos`
+        bool readDigits(std::string_view s, size_t &pos, size_t width, int64_t &value)
+        {
+            if (pos + width > s.size())
+                return false;
+
+            value = 0;
+            for (size_t i = 0; i < width; ++i)
+            {
+                char c = s[pos + i];
+                if (c < '0' || c > '9')
+                    return false;
+                value = value * 10 + (c - '0');
+            }
+            pos += width;
+            return true;
+        }
+
+        bool expect(std::string_view s, size_t &pos, char c)
+        {
+            if (pos >= s.size() || s[pos] != c)
+                return false;
+            ++pos;
+            return true;
+        }
+
+        // Civil date from days since epoch (inverse of daysFromCivil)
+        void civilFromDays(int64_t z, int64_t &year, unsigned &month, unsigned &day)
+        {
+            z += 719468;
+            const int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+            const unsigned doe = static_cast<unsigned>(z - era * 146097);
+            const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+            const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+            const unsigned mp = (5 * doy + 2) / 153;
+            day = doy - (153 * mp + 2) / 5 + 1;
+            month = mp < 10 ? mp + 3 : mp - 9;
+            year = static_cast<int64_t>(yoe) + era * 400 + (month <= 2);
+        }
+    }
+
+    int64_t daysFromCivil(int64_t year, unsigned month, unsigned day)
+    {
+        year -= month <= 2;
+        const int64_t era = (year >= 0 ? year : year - 399) / 400;
+        const unsigned yoe = static_cast<unsigned>(year - era * 400);
+        const unsigned doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+        const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        return era * 146097 + static_cast<int64_t>(doe) - 719468;
+    }
+
+    bool parseTimestamp(std::string_view text, int64_t &out)
+    {
+        while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front())))
+            text.remove_prefix(1);
+        while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back())))
+            text.remove_suffix(1);
+
+        size_t pos = 0;
+        int64_t year = 0, month = 0, day = 0;
+
+        if (text.size() >= 10 && text[4] == '-')
+        {
+            if (!readDigits(text, pos, 4, year) || !expect(text, pos, '-') ||
+                !readDigits(text, pos, 2, month) || !expect(text, pos, '-') ||
+                !readDigits(text, pos, 2, day))
+                return false;
+        }
+        else
+        {
+            if (!readDigits(text, pos, 2, month) || !expect(text, pos, '/') ||
+                !readDigits(text, pos, 2, day) || !expect(text, pos, '/') ||
+                !readDigits(text, pos, 4, year))
+                return false;
+        }
+
+        if (month < 1 || month > 12 || day < 1 || day > 31)
+            return false;
+
+        int64_t hour = 0, minute = 0, second = 0;
+        if (pos < text.size())
+        {
+            if (text[pos] != ' ' && text[pos] != 'T')
+                return false;
+            ++pos;
+            if (!readDigits(text, pos, 2, hour) || !expect(text, pos, ':') ||
+                !readDigits(text, pos, 2, minute))
+                return false;
+            if (pos < text.size() && (!expect(text, pos, ':') || !readDigits(text, pos, 2, second)))
+                return false;
+            if (pos != text.size() || hour > 23 || minute > 59 || second > 60)
+                return false;
+        }
+
+        out = daysFromCivil(year, static_cast<unsigned>(month), static_cast<unsigned>(day)) * 86400 +
+              hour * 3600 + minute * 60 + second;
+        return true;
+    }
+
+    std::string formatTimestamp(int64_t timestamp)
+    {
+        int64_t days = timestamp / 86400;
+        int64_t secs = timestamp % 86400;
+        if (secs < 0)
+        {
+            secs += 86400;
+            --days;
+        }
+
+        int64_t year = 0;
+        unsigned month = 0, day = 0;
+        civilFromDays(days, year, month, day);
+
+        // Room for every field at its widest (20-character long long, 10-character unsigned)
+        char buf[112];
+        std::snprintf(buf, sizeof(buf), "%04lld-%02u-%02u %02lld:%02lld:%02lld",
+                      static_cast<long long>(year), month, day,
+                      static_cast<long long>(secs / 3600), static_cast<long long>((secs / 60) % 60),
+                      static_cast<long long>(secs % 60));
+        return buf;
+    }
+}
@@ -0,0 +1,107 @@
+#include "ZoneBook.h"
+#include <algorithm>
+#include <iterator>
+
+void ZoneBook::update(const CandleSeries& candles, size_t i) {
+    changes.clear();
+    const double close = candles.close[i];
+
+    // Closes beyond the far edge; both sets are ordered so the victims sit at one end
+    while (!bullish.empty() && std::prev(bullish.end())->first > close) {
+        evict(std::prev(bullish.end())->second, ZoneState::Invalidated, i);
+    }
+    while (!bearish.empty() && bearish.begin()->first < close) {
+        evict(bearish.begin()->second, ZoneState::Invalidated, i);
+    }
+
+    touched.clear();
+    index.overlapping(candles.low[i], candles.high[i], touched);
+    for (ZoneIndex::Id id : touched) {
+        const OBZone& zone = slots[id].zone.zone;
+        if (close >= std::min(zone.bottom, zone.top) && close <= std::max(zone.bottom, zone.top)) {
+            evict(id, ZoneState::Mitigated, i);
+            continue;
+        }
+        BookZone& entry = slots[id].zone;
+        ++entry.touches;
+        entry.lastTouch = i;
+        if (entry.state == ZoneState::Fresh) {
+            entry.state = ZoneState::Touched;
+            --fresh;
+            changes.push_back({entry, i});
+        }
+    }
+
+    while (maxAgeBars > 0 && !ageQueue.empty()) {
+        const auto [serial, id] = ageQueue.front();
+        if (slots[id].live && slots[id].serial == serial) {
+            if (slots[id].zone.formedAt + maxAgeBars >= i) break;
+            evict(id, ZoneState::Invalidated, i);
+        }
+        ageQueue.pop_front();
+    }
+
+    if (i >= 2) {
+        confirmed.clear();
+        detectOrderBlocksAt(candles, i - 2, confirmed);
+        for (const auto& ob : confirmed) {
+            const ZoneIndex::Id id = add(ob.first, i - 2);
+            changes.push_back({slots[id].zone, i});
+        }
+    }
+    bars = i + 1;
+}
+
+ZoneIndex::Id ZoneBook::add(const OBZone& zone, size_t formedAt) {
+    const ZoneIndex::Id id = index.insert(zone);
+    if (id >= slots.size()) slots.resize(id + 1);
+
+    Slot& slot = slots[id];
+    slot.zone = BookZone{zone, ZoneState::Fresh, formedAt, 0, 0};
+    slot.serial = nextSerial++;
+    slot.live = true;
+    ++fresh;
+
+    if (zone.type == OBType::Bullish) bullish.emplace(std::min(zone.bottom, zone.top), id);
+    else bearish.emplace(std::max(zone.bottom, zone.top), id);
+    if (maxAgeBars > 0) ageQueue.emplace_back(slot.serial, id);
+    return id;
+}
+
+void ZoneBook::reset() {
+    index.clear();
+    slots.clear();
+    bullish.clear();
+    bearish.clear();
+    ageQueue.clear();
+    changes.clear();
+    fresh = 0;
+    bars = 0;
+}
+
+void ZoneBook::tradableAt(double price, std::vector<BookZone>& out) const {
+    index.forEachOverlapping(price, price, [&](ZoneIndex::Id id) { out.push_back(slots[id].zone); });
+}
+
+std::string ZoneBook::stateName(ZoneState state) {
+    switch (state) {
+        case ZoneState::Fresh: return "Fresh";
+        case ZoneState::Touched: return "Touched";
+        case ZoneState::Mitigated: return "Mitigated";
+        case ZoneState::Invalidated: return "Invalidated";
+    }
+    return "Unknown";
+}
+
+void ZoneBook::evict(ZoneIndex::Id id, ZoneState state, size_t i) {
+    Slot& slot = slots[id];
+    const OBZone& zone = slot.zone.zone;
+    if (zone.type == OBType::Bullish) bullish.erase({std::min(zone.bottom, zone.top), id});
+    else bearish.erase({std::max(zone.bottom, zone.top), id});
+    if (slot.zone.state == ZoneState::Fresh) --fresh;
+
+    slot.zone.state = state;
+    slot.live = false;
+    index.remove(id);
+    changes.push_back({slot.zone, i});
+}
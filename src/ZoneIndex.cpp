@@ -0,0 +1,104 @@
+#include "ZoneIndex.h"
+#include <algorithm>
+
+ZoneIndex::Id ZoneIndex::insert(const OBZone& zone) {
+    Id id;
+    if (!freeIds.empty()) {
+        id = freeIds.back();
+        freeIds.pop_back();
+    } else {
+        id = static_cast<Id>(nodes.size());
+        nodes.emplace_back();
+    }
+
+    // splitmix64 step for the heap priority
+    uint64_t z = (rngState += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+
+    Node& n = nodes[id];
+    n.zone = zone;
+    n.low = std::min(zone.bottom, zone.top);
+    n.high = std::max(zone.bottom, zone.top);
+    n.maxHigh = n.high;
+    n.priority = z ^ (z >> 31);
+    n.left = kNil;
+    n.right = kNil;
+    n.live = true;
+
+    const int32_t key = static_cast<int32_t>(id);
+    int32_t l, r;
+    split(root, key, l, r);
+    root = merge(merge(l, key), r);
+    ++count;
+    return id;
+}
+
+bool ZoneIndex::remove(Id id) {
+    if (!contains(id)) return false;
+    root = erase(root, static_cast<int32_t>(id));
+    nodes[id].live = false;
+    freeIds.push_back(id);
+    --count;
+    return true;
+}
+
+void ZoneIndex::clear() {
+    nodes.clear();
+    freeIds.clear();
+    root = kNil;
+    count = 0;
+}
+
+void ZoneIndex::overlapping(double low, double high, std::vector<Id>& out) const {
+    forEachOverlapping(low, high, [&out](Id id) { out.push_back(id); });
+}
+
+// Nodes are ordered by lower bound, ties by id
+bool ZoneIndex::less(int32_t a, int32_t b) const {
+    return nodes[a].low < nodes[b].low || (nodes[a].low == nodes[b].low && a < b);
+}
+
+void ZoneIndex::pull(int32_t t) {
+    Node& n = nodes[t];
+    n.maxHigh = n.high;
+    if (n.left != kNil) n.maxHigh = std::max(n.maxHigh, nodes[n.left].maxHigh);
+    if (n.right != kNil) n.maxHigh = std::max(n.maxHigh, nodes[n.right].maxHigh);
+}
+
+// Splits t into nodes ordered before `key` (l) and the rest (r)
+void ZoneIndex::split(int32_t t, int32_t key, int32_t& l, int32_t& r) {
+    if (t == kNil) {
+        l = r = kNil;
+        return;
+    }
+    if (less(t, key)) {
+        split(nodes[t].right, key, nodes[t].right, r);
+        l = t;
+    } else {
+        split(nodes[t].left, key, l, nodes[t].left);
+        r = t;
+    }
+    pull(t);
+}
+
+int32_t ZoneIndex::merge(int32_t l, int32_t r) {
+    if (l == kNil) return r;
+    if (r == kNil) return l;
+    if (nodes[l].priority > nodes[r].priority) {
+        nodes[l].right = merge(nodes[l].right, r);
+        pull(l);
+        return l;
+    }
+    nodes[r].left = merge(l, nodes[r].left);
+    pull(r);
+    return r;
+}
+
+int32_t ZoneIndex::erase(int32_t t, int32_t key) {
+    if (t == key) return merge(nodes[t].left, nodes[t].right);
+    if (less(key, t)) nodes[t].left = erase(nodes[t].left, key);
+    else nodes[t].right = erase(nodes[t].right, key);
+    pull(t);
+    return t;
+}
@@ -1,16 +1,18 @@
 #include <spdlog/spdlog.h>
 #include "Config.h"
-#include "OrderBlockAnalyzer.h"
+#include "AsyncLog.h"
+#include "MultiSymbolRunner.h"
 #include <thread>
 #include <chrono>
 #include <csignal>
 #include <atomic>
+#include <memory>
 
 std::atomic<bool> keepRunning(true);
 
+// Only the flag: logging may block on the queue or allocate, neither is async-signal-safe
 void signalHandler(int)
 {
-    spdlog::info("Signal received, shutting down...");
     keepRunning = false;
 }
 
@@ -33,15 +35,33 @@ int main()
         return 1;
     }
 
+    // From here on, log lines are written by a background thread
+    AsyncLog::Options logOptions;
+    logOptions.capacity = static_cast<size_t>(config.log_queue_size);
+    logOptions.overflow = config.log_overflow == "drop" ? LogOverflow::Drop : LogOverflow::Block;
+    logOptions.json = config.log_format == "json";
+    AsyncLog::start(logOptions);
+
     spdlog::info("Trading system started with config loaded.");
 
-    OrderBlockAnalyzer analyzer(config);
+    std::unique_ptr<MultiSymbolRunner> runner;
+    try
+    {
+        runner = std::make_unique<MultiSymbolRunner>(config);
+    }
+    catch (const std::exception &e)
+    {
+        spdlog::error("Failed to set up instruments: {}", e.what());
+        AsyncLog::stop();
+        return 1;
+    }
 
     while (keepRunning)
     {
+        // Per-instrument failures are caught by the runner; this catches the cycle itself
         try
         {
-            analyzer.analyze();
+            runner->runCycle();
         }
         catch (const std::exception &e)
         {
@@ -50,6 +70,8 @@ int main()
         std::this_thread::sleep_for(std::chrono::seconds(60));
     }
 
+    spdlog::info("Signal received, shutting down...");
     spdlog::info("Trading system exited cleanly.");
+    AsyncLog::stop();
     return 0;
 }
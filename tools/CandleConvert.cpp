@@ -0,0 +1,64 @@
+#include <iostream>
+#include <string>
+#include "CandleStore.h"
+#include "DataReader.h"
+#include "Utils.h"
+
+// Convert CSV or API candles into a binary candle store, or describe an existing store.
+//
+//   CandleConvert CSV <input.csv> <output.bin> [symbol] [timeframe]
+//   CandleConvert API <url> <output.bin> [symbol] [timeframe] [api_key]
+//   CandleConvert --info <store.bin>
+
+static int usage()
+{
+    std::cerr << "Usage:\n"
+              << "  CandleConvert CSV <input.csv> <output.bin> [symbol] [timeframe]\n"
+              << "  CandleConvert API <url> <output.bin> [symbol] [timeframe] [api_key]\n"
+              << "  CandleConvert --info <store.bin>\n";
+    return 2;
+}
+
+static int printInfo(const std::string &path)
+{
+    CandleSeries candles;
+    CandleStoreInfo info;
+    if (!CandleStore::read(path, candles, &info))
+        return 1;
+
+    std::cout << "Symbol:    " << (info.symbol.empty() ? "-" : info.symbol) << "\n"
+              << "Timeframe: " << (info.timeframe.empty() ? "-" : info.timeframe) << "\n"
+              << "Bars:      " << info.count << "\n";
+    if (!candles.empty())
+    {
+        std::cout << "First:     " << Utils::formatTimestamp(candles.timestamp.front()) << "\n"
+                  << "Last:      " << Utils::formatTimestamp(candles.timestamp.back()) << "\n";
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc == 3 && std::string(argv[1]) == "--info")
+        return printInfo(argv[2]);
+
+    if (argc < 4 || argc > 7)
+        return usage();
+
+    const std::string source = argv[1];
+    if (source != "CSV" && source != "API")
+        return usage();
+
+    const std::string input = argv[2];
+    const std::string output = argv[3];
+    const std::string symbol = argc > 4 ? argv[4] : "";
+    const std::string timeframe = argc > 5 ? argv[5] : "";
+    const std::string apiKey = argc > 6 ? argv[6] : "";
+
+    DataReader reader(source == "CSV" ? input : "", source, source == "API" ? input : "", apiKey, "mmap");
+    if (!reader.exportBinary(output, symbol, timeframe))
+        return 1;
+
+    std::cout << "Wrote " << output << "\n";
+    return 0;
+}
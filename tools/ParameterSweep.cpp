@@ -0,0 +1,129 @@
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "DataReader.h"
+#include "ParameterSweep.h"
+#include "json.hpp"
+
+// Backtest a grid (or a random sample) of strategy parameters and write a ranked table.
+//
+//   ParameterSweep <candles.csv|candles.bin> <sweep.json> <results.csv>
+//
+// sweep.json lists candidate values per parameter; missing keys keep the single default:
+//   {
+//     "swing_lookback": [2, 3, 5],
+//     "retrace_threshold": [0.01, 0.02],
+//     "trendline_threshold": [0.02],
+//     "trendline_pair_span": [1],  // as the analyzer's trendline_pair_span setting
+//     "atr_period": [14],
+//     "risk_atr_multiplier": [1.0, 1.5, 2.0],
+//     "reward_risk_ratio": [1.5, 2.0, 3.0],
+//     "samples": 0,              // 0 = full grid, otherwise that many random combinations
+//     "seed": 1,
+//     "threads": 0,              // 0 = one per core
+//     "initial_capital": 10000,
+//     "position_size": 1,
+//     "commission_per_trade": 0,
+//     "order_expiry_bars": 0
+//   }
+
+using json = nlohmann::json;
+
+static int usage()
+{
+    std::cerr << "Usage: ParameterSweep <candles.csv|candles.bin> <sweep.json> <results.csv>\n";
+    return 2;
+}
+
+template <typename T>
+static void readValues(const json &spec, const char *key, std::vector<T> &values)
+{
+    if (spec.contains(key))
+        values = spec[key].get<std::vector<T>>();
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 4)
+        return usage();
+
+    const std::string input = argv[1];
+    const bool binary = input.size() > 4 && input.compare(input.size() - 4, 4, ".bin") == 0;
+
+    json spec;
+    try
+    {
+        std::ifstream file(argv[2]);
+        if (!file.is_open())
+        {
+            std::cerr << "Could not open sweep file: " << argv[2] << "\n";
+            return 1;
+        }
+        file >> spec;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Invalid sweep file: " << e.what() << "\n";
+        return 1;
+    }
+
+    SweepSpace space;
+    BacktestConfig backtestConfig;
+    size_t samples = 0, threads = 0;
+    uint64_t seed = 1;
+    try
+    {
+        readValues(spec, "swing_lookback", space.swingLookbacks);
+        readValues(spec, "retrace_threshold", space.retraceThresholds);
+        readValues(spec, "trendline_threshold", space.trendlineThresholds);
+        readValues(spec, "trendline_pair_span", space.trendlinePairSpans);
+        readValues(spec, "atr_period", space.atrPeriods);
+        readValues(spec, "risk_atr_multiplier", space.riskATRMultipliers);
+        readValues(spec, "reward_risk_ratio", space.rewardRiskRatios);
+        samples = spec.value("samples", samples);
+        seed = spec.value("seed", seed);
+        threads = spec.value("threads", threads);
+        backtestConfig.initialCapital = spec.value("initial_capital", backtestConfig.initialCapital);
+        backtestConfig.positionSize = spec.value("position_size", backtestConfig.positionSize);
+        backtestConfig.commissionPerTrade = spec.value("commission_per_trade", backtestConfig.commissionPerTrade);
+        backtestConfig.orderExpiryBars = spec.value("order_expiry_bars", backtestConfig.orderExpiryBars);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Invalid sweep file: " << e.what() << "\n";
+        return 1;
+    }
+
+    DataReader reader(input, binary ? "BIN" : "CSV");
+    const CandleSeries candles = reader.readSeries();
+    if (candles.empty())
+    {
+        std::cerr << "No candles loaded from " << input << "\n";
+        return 1;
+    }
+
+    const std::vector<SweepParams> configs = samples ? space.sample(samples, seed) : space.grid();
+    if (configs.empty())
+    {
+        std::cerr << "Empty parameter space\n";
+        return 1;
+    }
+
+    const ParameterSweep sweep(candles, backtestConfig);
+    const std::vector<SweepResult> results = sweep.run(configs, threads);
+    if (!ParameterSweep::writeTable(argv[3], results))
+        return 1;
+
+    std::cout << "Ran " << results.size() << " backtests over " << candles.size() << " bars, wrote " << argv[3] << "\n";
+    const SweepResult &best = results.front();
+    std::cout << "Best: lookback=" << best.params.swingLookback
+              << " retrace=" << best.params.retraceThreshold
+              << " trendline=" << best.params.trendlineThreshold
+              << " span=" << best.params.trendlinePairSpan
+              << " atr=" << best.params.atrPeriod
+              << " risk=" << best.params.riskATRMultiplier
+              << " rr=" << best.params.rewardRiskRatio
+              << " -> net " << best.netProfit << " over " << best.trades << " trades, max drawdown "
+              << best.maxDrawdown << "\n";
+    return 0;
+}